@@ -10,30 +10,52 @@ TARGET = houio
 TEMPLATE = lib
 CONFIG += staticlib
 
+# the vendored half class (OpenEXR) declares an assignment operator but no copy constructor, which gcc 9+ flags with -Wextra
+*-g++*:QMAKE_CXXFLAGS += -Wno-deprecated-copy
+
 SOURCES += \
     src/Attribute.cpp \
+    src/BitSet.cpp \
     src/Field.cpp \
     src/math/Color.cpp \
     src/math/Math.cpp \
+    src/math/Half/half.cpp \
     src/json.cpp \
     src/HouGeoAdapter.cpp \
     src/HouGeo.cpp \
     src/HouGeoIO.cpp \
+    src/HouGeoExporter.cpp \
+    src/HouGeoPointWriter.cpp \
+    src/HouGeoStream.cpp \
+    src/HouGeoIndex.cpp \
+    src/HouGeoSequence.cpp \
+    src/HouGeoBatch.cpp \
+    src/HouGeoExportQueue.cpp \
     src/Geometry.cpp
 
 HEADERS += \
     include/houio/Attribute.h \
+    include/houio/BitSet.h \
     include/houio/Field.h \
     include/houio/HouGeo.h \
     include/houio/HouGeoAdapter.h \
     include/houio/HouGeoIO.h \
+    include/houio/HouGeoExporter.h \
+    include/houio/HouGeoPointWriter.h \
+    include/houio/HouGeoStream.h \
+    include/houio/HouGeoIndex.h \
+    include/houio/HouGeoSequence.h \
+    include/houio/HouGeoBatch.h \
+    include/houio/HouGeoExportQueue.h \
     include/houio/HouScene.h \
+    include/houio/Parallel.h \
     include/houio/ImportHoudini.h \
     include/houio/json.h \
     include/houio/types.h \
     include/houio/math/BoundingBox2.h \
     include/houio/math/BoundingBox3.h \
     include/houio/math/Color.h \
+    include/houio/math/Half/half.h \
     include/houio/math/Math.h \
     include/houio/math/Matrix22.h \
     include/houio/math/Matrix22Algo.h \
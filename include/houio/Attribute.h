@@ -9,22 +9,32 @@ namespace houio
 {
 
 	// basicly a list manager
+	// the data can be shared with other attributes (views), it is copied once the attribute is being written to
 	struct Attribute
 	{
 		typedef std::shared_ptr<Attribute> Ptr;
 		typedef std::shared_ptr<const Attribute> CPtr;
+		typedef std::shared_ptr< std::vector<unsigned char> > DataPtr;
 
 		enum ComponentType
 		{
 			INVALID,
 			INT,
-			FLOAT
+			FLOAT,
+			INT8,
+			UINT8,
+			INT16,
+			INT64,
+			HALF,
+			DOUBLE
 		};
 
 		Attribute( char numComponents=3, ComponentType componentType = FLOAT );
 		~Attribute();
 
 		Attribute::Ptr copy();
+		Attribute::Ptr convert( ComponentType componentType ); // returns copy with all components converted to given type
+		void           appendElements( Attribute::Ptr other ); // appends all elements of other (which must have the same layout)
 
 		template<typename T>
 		unsigned int appendElement( const T &value );
@@ -36,7 +46,9 @@ namespace houio
 		unsigned int appendElement( const T &v0, const T &v1, const T &v2, const T &v3 );
 
 		template<typename T>
-		T &get( unsigned int index );
+		T &get( unsigned int index ); // detaches shared data
+		template<typename T>
+		const T &get( unsigned int index )const; // reads directly from shared data
 
 		template<typename T>
 		void set( unsigned int index, T value );
@@ -50,25 +62,28 @@ namespace houio
 
 		void clear()
 		{
-			m_data.clear();
+			m_data = std::make_shared< std::vector<unsigned char> >();
+			m_offset = 0;
+			m_stride = elementSize();
 			m_numElements = 0;
 			m_isDirty = true;
 		}
 
 		void resize( size_t numElements )
 		{
-			m_data.resize( numElements*numComponents()*elementComponentSize() );
+			detach();
+			m_data->resize( numElements*elementSize() );
 			m_numElements = numElements;
 			m_isDirty = true;
 		}
 
 
-		int numElements()
+		int numElements()const
 		{
 			return m_numElements;
 		}
 
-		int numComponents()
+		int numComponents()const
 		{
 			return m_numComponents;
 		}
@@ -80,23 +95,51 @@ namespace houio
 			return m_componentSize;
 		}
 
+		int elementSize()const
+		{
+			return m_numComponents*m_componentSize;
+		}
+
+		// detaches shared data
 		void *getRawPointer()
 		{
-			if (m_data.empty())
+			detach();
+			if (m_data->empty())
 				return 0;
-			return (void *)&m_data[0];
+			return (void *)&(*m_data)[0];
 		}
+		// detaches shared data
 		void *getRawPointer( int index )
 		{
+			detach();
 			// should change on e per type basis
-			return (void *)&m_data[index*numComponents()*elementComponentSize()];
+			return (void *)&(*m_data)[index*elementSize()];
 		}
 
+		// read access without detaching, elements are stride bytes apart
+		const void *data( int index = 0 )const
+		{
+			if (m_data->empty())
+				return 0;
+			return (const void *)&(*m_data)[m_offset + index*m_stride];
+		}
+		size_t stride()const
+		{
+			return m_stride;
+		}
 
+		bool isShared()const; // data is shared with other attributes
+		bool isPacked()const; // elements are stored without gaps
+		void detach(); // makes sure data is packed and not shared with other attributes
 
+		// creates attribute which shares the data of source, the view may skip components of the source
+		// (e.g. xyz of a 4 component position) - data is copied as soon as either attribute is written to
+		static Attribute::Ptr createView( Attribute::Ptr source, char numComponents, int componentOffset = 0 );
 
 
-		std::vector<unsigned char> m_data;
+		DataPtr           m_data; // shared among attributes until written to
+		size_t            m_offset; // byte offset of the first element within m_data
+		size_t            m_stride; // byte distance between elements within m_data
 		char              m_componentSize; // size in memory of a component of an element in byte
 		ComponentType     m_componentType;
 		char              m_numComponents; // number of components per element
@@ -121,15 +164,19 @@ namespace houio
 		static ComponentType   componentType(const std::string& ct );
 
 		bool                   m_isDirty; // indicates update on gpu required
+
+	private:
+		void                   gather( unsigned char *dst )const; // copies elements into dst without gaps
 	};
 
 
 	template<typename T>
 	unsigned int Attribute::appendElement( const T &value )
 	{
-		unsigned int pos = (unsigned int) m_data.size();
-		m_data.resize( pos + sizeof(T) );
-		*((T *)&m_data[pos]) = value;
+		detach();
+		unsigned int pos = (unsigned int) m_data->size();
+		m_data->resize( pos + sizeof(T) );
+		*((T *)&(*m_data)[pos]) = value;
 		m_isDirty = true;
 		return m_numElements++;
 	}
@@ -137,9 +184,10 @@ namespace houio
 	template<typename T>
 	unsigned int Attribute::appendElement( const T &v0, const T &v1 )
 	{
-		unsigned int pos = (unsigned int) m_data.size();
-		m_data.resize( pos + sizeof(T)*2 );
-		T *data = (T*)&m_data[pos];
+		detach();
+		unsigned int pos = (unsigned int) m_data->size();
+		m_data->resize( pos + sizeof(T)*2 );
+		T *data = (T*)&(*m_data)[pos];
 		*data = v0;++data;
 		*data = v1;++data;
 		m_isDirty = true;
@@ -149,9 +197,10 @@ namespace houio
 	template<typename T>
 	unsigned int Attribute::appendElement( const T &v0, const T &v1, const T &v2 )
 	{
-		unsigned int pos = (unsigned int) m_data.size();
-		m_data.resize( pos + sizeof(T)*3 );
-		T *data = (T*)&m_data[pos];
+		detach();
+		unsigned int pos = (unsigned int) m_data->size();
+		m_data->resize( pos + sizeof(T)*3 );
+		T *data = (T*)&(*m_data)[pos];
 		*data = v0;++data;
 		*data = v1;++data;
 		*data = v2;++data;
@@ -162,9 +211,10 @@ namespace houio
 	template<typename T>
 	unsigned int Attribute::appendElement( const T &v0, const T &v1, const T &v2, const T &v3 )
 	{
-		unsigned int pos = (unsigned int) m_data.size();
-		m_data.resize( pos + sizeof(T)*4 );
-		T *data = (T*)&m_data[pos];
+		detach();
+		unsigned int pos = (unsigned int) m_data->size();
+		m_data->resize( pos + sizeof(T)*4 );
+		T *data = (T*)&(*m_data)[pos];
 		*data = v0;++data;
 		*data = v1;++data;
 		*data = v2;++data;
@@ -176,14 +226,28 @@ namespace houio
 	template<typename T>
 	T &Attribute::get( unsigned int index )
 	{
-		T *data = (T*)&m_data[index * sizeof(T)];
+		detach();
+		m_isDirty = true;
+		T *data = (T*)&(*m_data)[index * sizeof(T)];
+		return *data;
+	}
+
+	template<typename T>
+	const T &Attribute::get( unsigned int index )const
+	{
+		size_t offset = index * sizeof(T);
+		// views address elements through their stride
+		if( m_stride != (size_t)elementSize() )
+			offset = (offset/elementSize())*m_stride + offset%elementSize();
+		const T *data = (const T*)&(*m_data)[m_offset + offset];
 		return *data;
 	}
 
 	template<typename T>
 	void Attribute::set( unsigned int index, T value )
 	{
-		T *data = (T*)&m_data[index * sizeof(T)];
+		detach();
+		T *data = (T*)&(*m_data)[index * sizeof(T)];
 		*data = value;
 		m_isDirty = true;
 	}
@@ -191,7 +255,8 @@ namespace houio
 	template<typename T>
 	void Attribute::set( unsigned int index, T v0, T v1 )
 	{
-		T *data = (T*)&m_data[index * sizeof(T) * 2];
+		detach();
+		T *data = (T*)&(*m_data)[index * sizeof(T) * 2];
 		*data++ = v0;
 		*data++ = v1;
 		m_isDirty = true;
@@ -200,7 +265,8 @@ namespace houio
 	template<typename T>
 	void Attribute::set( unsigned int index, T v0, T v1, T v2 )
 	{
-		T *data = (T*)&m_data[index * sizeof(T) * 3];
+		detach();
+		T *data = (T*)&(*m_data)[index * sizeof(T) * 3];
 		*data++ = v0;
 		*data++ = v1;
 		*data++ = v2;
@@ -210,7 +276,8 @@ namespace houio
 	template<typename T>
 	void Attribute::set( unsigned int index, T v0, T v1, T v2, T v3 )
 	{
-		T *data = (T*)&m_data[index * sizeof(T) * 4];
+		detach();
+		T *data = (T*)&(*m_data)[index * sizeof(T) * 4];
 		*data++ = v0;
 		*data++ = v1;
 		*data++ = v2;
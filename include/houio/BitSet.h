@@ -0,0 +1,101 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include <houio/types.h>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+
+
+namespace houio
+{
+	// packed set of bits, used for point and primitive groups
+	// bits are stored in 32bit words, least significant bit first (same layout as bool bitstreams in bgeo files)
+	struct BitSet
+	{
+		typedef std::shared_ptr<BitSet> Ptr;
+
+		BitSet( size_t size = 0, bool value = false );
+
+		static Ptr                create( size_t size = 0, bool value = false );
+		Ptr                       copy()const;
+
+		size_t                    size()const;
+		void                      resize( size_t size, bool value = false );
+
+		bool                      test( size_t index )const;
+		void                      set( size_t index, bool value = true );
+		void                      reset( size_t index );
+		void                      setAll( bool value = true );
+		void                      flip();
+
+		size_t                    count()const; // number of set bits
+		bool                      any()const;
+		bool                      none()const;
+		size_t                    findFirst()const; // returns size() if no bit is set
+		size_t                    findNext( size_t index )const; // first set bit after index, returns size() if there is none
+		void                      getIndices( std::vector<int> &indices )const;
+
+		template<typename F>
+		void                      forEach( F f )const; // calls f for the index of each set bit
+
+		BitSet&                   operator|=( const BitSet &other );
+		BitSet&                   operator&=( const BitSet &other );
+		BitSet&                   operator^=( const BitSet &other );
+		BitSet&                   subtract( const BitSet &other ); // removes all bits which are set in other
+
+		size_t                    numWords()const;
+		uint32*                   getRawPointer();
+		const uint32*             getRawPointer()const;
+
+		void                      clearUnusedBits(); // keeps bits beyond size zero so that count and iteration work on whole words (call after writing through raw pointer)
+
+		static int                countTrailingZeros( uint32 word ); // word must not be zero
+		static int                popCount( uint32 word );
+
+	private:
+		std::vector<uint32>       m_words;
+		size_t                    m_size;
+	};
+
+
+	template<typename F>
+	void BitSet::forEach( F f )const
+	{
+		size_t numWords = m_words.size();
+		for( size_t w=0;w<numWords;++w )
+		{
+			uint32 word = m_words[w];
+			while( word )
+			{
+				f( w*32 + countTrailingZeros(word) );
+				// clear lowest set bit
+				word &= word - 1;
+			}
+		}
+	}
+
+	inline int BitSet::countTrailingZeros( uint32 word )
+	{
+#if _MSC_VER
+		unsigned long index;
+		_BitScanForward( &index, word );
+		return (int)index;
+#else
+		return __builtin_ctz( word );
+#endif
+	}
+
+	inline int BitSet::popCount( uint32 word )
+	{
+#if _MSC_VER
+		return (int)__popcnt( word );
+#else
+		return __builtin_popcount( word );
+#endif
+	}
+
+} // namespace houio
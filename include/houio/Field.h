@@ -5,6 +5,7 @@
 #include <fstream>
 #include <memory>
 #include <cstring>
+#include <stdexcept>
 
 #include <houio/math/Math.h>
 
@@ -45,16 +46,23 @@ namespace houio
 		math::V3f                               localToVoxel( const math::V3f &lsP )const; // converts given localspace position to voxelspace
 		math::V3f                               voxelToLocal( const math::V3f &vsP )const; // converts given voxelspace position to localspace
 
-		T                                                                *getRawPointer();
+		T                                                                *getRawPointer(); // detaches shared voxel data
 		const T                                                     *getRawPointer()const;
 
+		// voxel data sharing (copy on write) ---
+		typedef std::shared_ptr< std::vector<T> > DataPtr;
+		DataPtr                                                               getData()const; // returns voxel buffer for sharing with other fields
+		void                                                   setData( DataPtr data ); // shares given voxel buffer (has to match resolution)
+		bool                                                                 isShared()const; // true if voxel buffer is referenced by other fields
+		void                                                                        detach(); // makes voxel buffer unique before it gets written
+
 
 		// utility functions ---
 		void                                                               fill( T value ); // fills all voxels with the same value
 		void                                   fill( T value, const math::Box3f &wsBound ); // fills all voxels with the same value within given (worldspace)bound
 		void                                                           multiply( T value ); // multiplies all voxelswith given value
-		void                                          store( const std::string &filename ); // saves field to file
-		void                        storeWithoutBoundingBox( const std::string &filename ); // saves field to file
+		void                                     store( const std::string &filename )const; // saves field to file
+		void                   storeWithoutBoundingBox( const std::string &filename )const; // saves field to file
 
 
 
@@ -70,7 +78,7 @@ namespace houio
 
 		math::Box3f                                                                m_bound;
 
-		std::vector<T>                                                              m_data;
+		DataPtr                                                                     m_data; // shared among fields until written to
 
 		static const int                                                        m_dataType; // e.g. float, double, v3f etc.
 	};
@@ -101,9 +109,9 @@ namespace houio
 	typename Field<T>::Ptr Field<T>::create( typename Field<R>::Ptr src)
 	{
 		Field<T>::Ptr dst = Field<T>::create( src->getResolution(), src->bound() );
-		typename std::vector<R>::iterator srcIt = src->m_data.begin();
-		typename std::vector<T>::iterator dstIt = dst->m_data.begin();
-		typename std::vector<T>::iterator dstEnd = dst->m_data.end();
+		typename std::vector<R>::const_iterator srcIt = src->m_data->begin();
+		typename std::vector<T>::iterator dstIt = dst->m_data->begin();
+		typename std::vector<T>::iterator dstEnd = dst->m_data->end();
 		for( ; dstIt != dstEnd; ++dstIt, ++srcIt )
 			*dstIt = (T)*srcIt;
 		return dst;
@@ -139,8 +147,8 @@ namespace houio
 		}
 
 		int size = field->m_resolution.x*field->m_resolution.y*field->m_resolution.z;
-		field->m_data.resize( size );
-		in.read( (char *)&field->m_data[0], size*sizeof(T) );
+		field->m_data = std::make_shared< std::vector<T> >( size );
+		in.read( (char *)field->getRawPointer(), size*sizeof(T) );
 
 		// need to to this to trigger update of matrices
 		field->setBound( field->m_bound );
@@ -149,7 +157,7 @@ namespace houio
 	}
 
 	template<typename T>
-	void Field<T>::store( const std::string &filename )
+	void Field<T>::store( const std::string &filename )const
 	{
 		std::ofstream out( filename.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
 
@@ -158,18 +166,18 @@ namespace houio
 		math::Box3f b = bound();
 		out.write( (const char *)&b, sizeof(float)*6 );
 		out.write( (const char *)&m_dataType, sizeof(int) );
-		out.write( (const char *)&m_data[0], sizeof(T)*m_resolution.x*m_resolution.y*m_resolution.z );
+		out.write( (const char *)getRawPointer(), sizeof(T)*m_resolution.x*m_resolution.y*m_resolution.z );
 	}
 
 	template<typename T>
-	void Field<T>::storeWithoutBoundingBox( const std::string &filename )
+	void Field<T>::storeWithoutBoundingBox( const std::string &filename )const
 	{
 		std::ofstream out( filename.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
 
 		// save bound, resolution, data to file
 		out.write( (const char *)&m_resolution, sizeof(int)*3 );
 		out.write( (const char *)&m_dataType, sizeof(int) );
-		out.write( (const char *)&m_data[0], sizeof(T)*m_resolution.x*m_resolution.y*m_resolution.z );
+		out.write( (const char *)getRawPointer(), sizeof(T)*m_resolution.x*m_resolution.y*m_resolution.z );
 	}
 
 	template<typename T>
@@ -183,8 +191,10 @@ namespace houio
 	void Field<T>::resize( math::V3i resolution )
 	{
 		m_resolution = resolution;
-		m_data.resize(m_resolution.x*m_resolution.y*m_resolution.z);
-		memset( &m_data[0], 0, m_resolution.x*m_resolution.y*m_resolution.z*sizeof(T));
+		// always allocate a fresh buffer, the old one might be shared with other fields
+		m_data = std::make_shared< std::vector<T> >( m_resolution.x*m_resolution.y*m_resolution.z );
+		if( !m_data->empty() )
+			memset( m_data->data(), 0, m_resolution.x*m_resolution.y*m_resolution.z*sizeof(T));
 		m_worldToVoxel = m_worldToLocal*math::M44f().scale( math::V3f(m_resolution) );
 		m_voxelToWorld = m_worldToVoxel.inverse();
 	}
@@ -192,13 +202,14 @@ namespace houio
 	template<typename T>
 	T Field<T>::sample( int i, int j, int k )const
 	{
-		return m_data[k*m_resolution.x*m_resolution.y + j*m_resolution.x + i];
+		return (*m_data)[k*m_resolution.x*m_resolution.y + j*m_resolution.x + i];
 	}
 
 	template<typename T>
 	T &Field<T>::lvalue( int i, int j, int k )
 	{
-		return m_data[k*m_resolution.x*m_resolution.y + j*m_resolution.x + i];
+		detach();
+		return (*m_data)[k*m_resolution.x*m_resolution.y + j*m_resolution.x + i];
 	}
 
 	template<typename T>
@@ -256,13 +267,43 @@ namespace houio
 	template<typename T>
 	T *Field<T>::getRawPointer()
 	{
-		return &m_data[0];
+		detach();
+		return m_data->data();
 	}
 
+	// reading through the const overload keeps voxel data shared
 	template<typename T>
 	const T *Field<T>::getRawPointer()const
 	{
-		return &m_data[0];
+		return m_data->data();
+	}
+
+	template<typename T>
+	typename Field<T>::DataPtr Field<T>::getData()const
+	{
+		return m_data;
+	}
+
+	template<typename T>
+	void Field<T>::setData( DataPtr data )
+	{
+		if( !data || (int)data->size() != m_resolution.x*m_resolution.y*m_resolution.z )
+			throw std::runtime_error( "Field<T>::setData: size of voxel data doesnt match resolution" );
+		m_data = data;
+	}
+
+	template<typename T>
+	bool Field<T>::isShared()const
+	{
+		return m_data.use_count() > 1;
+	}
+
+	// copy on write: voxel data which is referenced by other fields gets copied before being modified
+	template<typename T>
+	void Field<T>::detach()
+	{
+		if( isShared() )
+			m_data = std::make_shared< std::vector<T> >( *m_data );
 	}
 
 	template<typename T>
@@ -351,7 +392,10 @@ namespace houio
 	template<typename T>
 	void Field<T>::fill( T value )
 	{
-		for( typename std::vector<T>::iterator it = m_data.begin(), end = m_data.end(); it != end; ++it )
+		// no need to copy data which will be overwritten anyway
+		if( isShared() )
+			m_data = std::make_shared< std::vector<T> >( m_data->size() );
+		for( typename std::vector<T>::iterator it = m_data->begin(), end = m_data->end(); it != end; ++it )
 			*it = value;
 	}
 
@@ -374,7 +418,8 @@ namespace houio
 	template<typename T>
 	void Field<T>::multiply( T value )
 	{
-		for( typename std::vector<T>::iterator it = m_data.begin(), end = m_data.end(); it != end; ++it )
+		detach();
+		for( typename std::vector<T>::iterator it = m_data->begin(), end = m_data->end(); it != end; ++it )
 			*it *= value;
 	}
 
@@ -395,7 +440,7 @@ namespace houio
 	template<typename T>
 	void field_range( const Field<T> &field, T& min, T& max )
 	{
-		auto minmax = std::minmax_element( field.m_data.begin(), field.m_data.end() );
+		auto minmax = std::minmax_element( field.m_data->begin(), field.m_data->end() );
 		min = *minmax.first;
 		max = *minmax.second;
 	}
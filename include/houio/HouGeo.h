@@ -1,8 +1,12 @@
 #pragma once
 
 
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <string>
+#include <functional>
 
 #include <houio/Field.h>
 #include <houio/Attribute.h>
@@ -34,17 +38,23 @@ namespace houio
 			virtual void                          getPacking( std::vector<int> &packing )const;
 			virtual int                           getNumElements()const;
 			virtual std::string                   getString( int index )const;
-			virtual RawPointer::Ptr               getRawPointer();
+			virtual void                          getStringTable( std::vector<std::string> &strings, std::vector<sint32> &indices )const;
+			virtual const std::vector<std::string>* getStrings()const override;
+			virtual const std::vector<sint32>*    getStringIndices()const override;
+			virtual RawPointer::Ptr               getRawPointer(); // detaches shared data
+			virtual const void*                   getDataPointer()const override; // shared data is read in place, 0 if it is not packed
 
 			//int                                   addV4f(math::V4f value);
-			int                                   addString(const std::string &value);
+			int                                   addString(const std::string &value); // appends an element, equal strings share one table entry
 
 			std::string                           m_name;
 			int                                   tupleSize;
 			Storage                               m_storage;
 			Type                                  m_type;
 			//std::vector<char>                     data;
-			std::vector<std::string>              strings; // used in case of type==string
+			std::vector<std::string>              strings; // unique strings, used in case of type==string
+			std::vector<sint32>                   stringIndices; // per element index into strings (-1 = no string)
+			std::unordered_map<std::string, sint32> stringLookup; // string -> index into strings, kept up to date by addString
 			int                                   numElements;
 
 			Attribute::Ptr                        m_attr; // primitives::Attribute
@@ -57,6 +67,7 @@ namespace houio
 			virtual void                          getIndices( std::vector<int> &indices )const override;
 			virtual void                          addIndices( std::vector<int> &indices );
 			virtual sint64                        getNumIndices()const;
+			virtual const int*                    getIndexPointer()const override;
 
 			std::vector<int>                      indexBuffer;
 		};
@@ -65,42 +76,71 @@ namespace houio
 		struct HouVolume : public VolumePrimitive
 		{
 			typedef std::shared_ptr<HouVolume> Ptr;
+			HouVolume();
 			virtual math::M44f                                getTransform()const;
 			virtual int                                       getVertex()const;
 			virtual math::Vec3i                               getResolution()const;
-			virtual RawPointer::Ptr                           getRawPointer(); // returns raw pointer to the data
+			virtual RawPointer::Ptr                           getRawPointer(); // returns raw pointer to the data (detaches shared voxel data)
+			virtual const real32*                             getVoxelPointer()const override; // voxels for reading, shared voxel data is not detached
 			virtual real32                                    getVoxel( int i, int j, int k )const;
+			std::string                                       getName()const; // value of the name primitive attribute
+			ScalarField::Ptr                                  getField(); // decodes voxel data on first access if volume has been loaded lazily
+			ScalarField::CPtr                                 getField()const;
+			bool                                              isDecoded()const;
 
-			ScalarField::Ptr                                  field;
+			mutable ScalarField::Ptr                          field; // null until decoded
 			int                                               vertex; // hougeo uses point indices to encode translation
+			std::string                                       name;
+			math::V3i                                         resolution; // resolution and transform are known before voxels are decoded
+			math::M44f                                        localToWorld;
+			mutable std::function<void(ScalarField&)>         decode; // decodes voxel data into given field (pending until field is requested), released once it has run
+		private:
+			void                                              decodeOnce()const; // volumes may be read from multiple threads
+			mutable std::once_flag                            m_decodeFlag;
+			mutable std::atomic<bool>                         m_decoded;
 		};
 
 		struct HouPoly : public PolyPrimitive
 		{
 			typedef std::shared_ptr<HouPoly> Ptr;
+			HouPoly();
 			virtual int                                       numPolys()const override;
 			virtual int                                       numVertices( int poly )const override;
 			virtual int const*                                vertices(int poly=0)const override;
 			virtual bool                                      closed()const override;
+			virtual int                                       startVertex()const override; // m_startVertex (m_vertices hold point indices once loaded, so they cant be scanned)
 			int                                               m_numPolys;
 			std::vector<int>                                  m_perPolyVertexCount; // holds number of vertices for each polygon
 			std::vector<int>                                  m_perPolyVertexListOffset; // holds offset into m_vertices per poly
 			std::vector<int>                                  m_vertices; // vertex indicess for each vertex
 			bool                                              m_closed;
+			int                                               m_startVertex; // first vertex if the vertices of all polys are numbered sequentially, -1 otherwise
 		};
 
 
 
 
+		typedef std::function<json::ArrayPtr( sint64 primitive, sint64 tile )> TileLoader; // returns the json array of a tile of the given volume primitive
+
+
 		HouGeo();
 
 		static HouGeo::Ptr                                   create();
 
 		void                                                 setPointAttribute( HouAttribute::Ptr attr );
 		void                                                 setPrimitiveAttribute( const std::string &name, HouAttribute::Ptr attr );
+		void                                                 setVertexAttribute( HouAttribute::Ptr attr );
+		void                                                 setGlobalAttribute( HouAttribute::Ptr attr );
+		void                                                 setPointGroup( const std::string &name, BitSet::Ptr group );
+		void                                                 setPrimitiveGroup( const std::string &name, BitSet::Ptr group );
 		void                                                 addPrimitive( ScalarField::Ptr field );
 		void                                                 addPrimitive( PolyPrimitive::Ptr poly );
 		void                                                 setTopology( HouTopology::Ptr topo );
+		void                                                 setVolumeRegion( const math::Box3f &region, bool voxelSpace = false ); // volumes will be cropped to given region during load (only intersecting tiles are decoded)
+		void                                                 setLazyVolumeLoading( bool lazy ); // voxel data of volumes will be decoded on first call to HouVolume::getField
+		void                                                 setTileLoader( const TileLoader &loader ); // volume tiles are requested from the loader instead of the json document (see HouGeoIndex)
+		void                                                 getVolumes( std::vector<HouVolume::Ptr>& volumes );
+		HouVolume::Ptr                                       getVolume( const std::string &name );
 
 
 		// inherited from HouGeoAdapter
@@ -118,25 +158,40 @@ namespace houio
 		virtual void                                         getGlobalAttributeNames( std::vector<std::string> &names )const override;
 		virtual AttributeAdapter::Ptr                        getGlobalAttribute( const std::string &name ) override;
 		virtual Topology::Ptr                                getTopology() override;
+		virtual void                                         getPointGroupNames( std::vector<std::string> &names )const override;
+		virtual BitSet::Ptr                                  getPointGroup( const std::string &name ) override;
+		virtual void                                         getPrimitiveGroupNames( std::vector<std::string> &names )const override;
+		virtual BitSet::Ptr                                  getPrimitiveGroup( const std::string &name ) override;
 
 
 
 
 		// this structure carries some global json data which I dont want to have as members of hougeo
+		// voxel blocks which have been decoded already, shared by all volumes referencing them
+		struct DecodedVoxelData
+		{
+			std::mutex                                                     mutex; // lazily loaded volumes are decoded on the thread which requests them
+			std::map<std::string, std::weak_ptr< std::vector<float> > >   blocks;
+		};
 		struct SharedPrimitiveData
 		{
+			SharedPrimitiveData() : decodedVoxelData(std::make_shared<DecodedVoxelData>()){}
 			std::map<std::string, json::ObjectPtr> sharedVoxelData;
+			std::shared_ptr<DecodedVoxelData>      decodedVoxelData; // outlives loading when volumes are decoded lazily
 		};
 
 		void                                                 load( json::ObjectPtr o ); // a has to be the root of the array from hou geo
-		HouAttribute::Ptr                                    loadAttribute( json::ArrayPtr attribute, sint64 elementCount );
+		static HouAttribute::Ptr                             loadAttribute( json::ArrayPtr attribute, sint64 elementCount );
 		void                                                 loadTopology( json::ObjectPtr o );
-		void                                                 loadPrimitive( json::ArrayPtr primitive, SharedPrimitiveData& sharedPrimitiveData );
-		void                                                 loadVolumePrimitive( json::ObjectPtr volume, SharedPrimitiveData& sharedPrimitiveData );
+		static BitSet::Ptr                                   loadGroup( json::ArrayPtr group, sint64 elementCount, std::string &name );
+		void                                                 loadPrimitive( json::ArrayPtr primitive, SharedPrimitiveData& sharedPrimitiveData, sint64 primitiveIndex );
+		void                                                 loadVolumePrimitive( json::ObjectPtr volume, SharedPrimitiveData& sharedPrimitiveData, sint64 primitiveIndex );
 		void                                                 loadPolyPrimitive( json::ObjectPtr poly );
 		void                                                 loadPolyPrimitiveRun( json::ObjectPtr def, json::ArrayPtr run );
+		void                                                 loadPolygonRun( json::ObjectPtr run );
 
-		void                                                 loadVoxelData( json::ObjectPtr voxels, const math::V3i& res, float* volData );
+		static void                                          loadVoxelData( json::ObjectPtr voxels, const math::V3i& res, float* volData );
+		static void                                          loadVoxelData( json::ObjectPtr voxels, const math::V3i& res, float* volData, const math::V3i& voxelMin, const math::V3i& voxelMax, const std::function<json::ArrayPtr( sint64 tile )> &tileLoader = std::function<json::ArrayPtr( sint64 tile )>() );
 
 
 		static json::ObjectPtr                               toObject( json::ArrayPtr a ); // turns json array into jsonObject (every first entry is key, every second is value)
@@ -148,6 +203,14 @@ namespace houio
 		std::map<std::string, HouAttribute::Ptr>                        m_primitiveAttributes;
 		std::map<std::string, HouAttribute::Ptr>                           m_globalAttributes;
 		HouTopology::Ptr                                                           m_topology;
+		std::map<std::string, BitSet::Ptr>                                      m_pointGroups;
+		std::map<std::string, BitSet::Ptr>                                  m_primitiveGroups;
+
+		bool                                                                m_hasVolumeRegion;
+		bool                                                       m_volumeRegionIsVoxelSpace;
+		math::Box3f                                                            m_volumeRegion;
+		bool                                                           m_lazyVolumeLoading;
+		TileLoader                                                          m_tileLoader;
 	};
 
 
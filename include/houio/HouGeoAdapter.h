@@ -7,9 +7,11 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <houio/Attribute.h>
+#include <houio/BitSet.h>
 #include <houio/math/Math.h>
 #include <houio/types.h>
 
@@ -47,7 +49,12 @@ namespace houio
 				ATTR_STORAGE_INVALID  = 0,
 				ATTR_STORAGE_FPREAL32 = 1,
 				ATTR_STORAGE_FPREAL64 = 2,
-				ATTR_STORAGE_INT32 = 3
+				ATTR_STORAGE_INT32 = 3,
+				ATTR_STORAGE_FPREAL16 = 4,
+				ATTR_STORAGE_INT8 = 5,
+				ATTR_STORAGE_INT16 = 6,
+				ATTR_STORAGE_INT64 = 7,
+				ATTR_STORAGE_UINT8 = 8
 			};
 			virtual std::string              getName()const;
 			virtual Type                     getType()const;
@@ -56,9 +63,14 @@ namespace houio
 			virtual void                     getPacking( std::vector<int> &packing )const;
 			virtual int                      getNumElements()const;
 			virtual RawPointer::Ptr          getRawPointer();
+			virtual const void*              getDataPointer()const; // packed data for reading without copying it, 0 if it isnt stored in one block (getRawPointer is used then)
 			virtual std::string              getString( int index )const=0;
+			virtual void                     getStringTable( std::vector<std::string> &strings, std::vector<sint32> &indices )const; // unique strings and per element indices, default dedupes getString
+			virtual const std::vector<std::string>* getStrings()const; // string table without copying it, 0 if the attribute doesnt keep one (getStringTable is used then)
+			virtual const std::vector<sint32>* getStringIndices()const; // per element indices into getStrings, 0 if the attribute doesnt keep them
 			static Type                      type( const std::string &typeName );
 			static Storage                   storage( const std::string &storageName );
+			static std::string               storageName( Storage storage );
 			static int                       storageSize( Storage storage );
 		};
 
@@ -71,6 +83,7 @@ namespace houio
 			virtual void                          getIndices( std::vector<int> &indices )const=0;
 			virtual void                          addIndices( std::vector<int> &indices )=0;
 			virtual sint64                        getNumIndices()const=0;
+			virtual const int*                    getIndexPointer()const; // indices without copying them, 0 if they are not stored in one block
 		};
 
 		struct Primitive
@@ -96,6 +109,7 @@ namespace houio
 			virtual math::Vec3i                getResolution()const;
 			virtual real32                     getVoxel( int i, int j, int k )const=0;
 			virtual RawPointer::Ptr            getRawPointer(); // returns raw pointer to the data
+			virtual const real32*              getVoxelPointer()const; // voxels without copying them, 0 if they are not stored in one block
 		};
 
 		struct PolyPrimitive : public Primitive
@@ -107,6 +121,7 @@ namespace houio
 			virtual int const*                 vertices(int poly=0)const;
 			virtual int numPrimitives()const override{return numPolys();}
 			virtual bool closed()const;
+			virtual int startVertex()const; // first vertex if the vertices of all polys are numbered sequentially, -1 otherwise (default scans vertices, assuming they are vertex numbers)
 		};
 
 
@@ -124,6 +139,10 @@ namespace houio
 		virtual AttributeAdapter::Ptr getPrimitiveAttribute( const std::string &name )=0;
 		virtual void                  getPrimitives( std::vector<HouGeoAdapter::Primitive::Ptr>& primitives );
 		virtual Topology::Ptr         getTopology();
+		virtual void                  getPointGroupNames( std::vector<std::string> &names )const;
+		virtual BitSet::Ptr           getPointGroup( const std::string &name );
+		virtual void                  getPrimitiveGroupNames( std::vector<std::string> &names )const;
+		virtual BitSet::Ptr           getPrimitiveGroup( const std::string &name );
 	};
 
 
@@ -0,0 +1,31 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <houio/types.h>
+#include <houio/Geometry.h>
+
+
+
+namespace houio
+{
+	// imports many bgeo files concurrently
+	// files are taken in the given order and admitted as long as the estimated memory of the files in flight fits into the budget
+	// (a file which exceeds the budget on its own is imported alone)
+	struct HouGeoBatch
+	{
+		struct Result
+		{
+			size_t                                index; // index into the list of paths
+			std::string                           path;
+			Geometry::Ptr                         geometry; // null if the import failed
+			std::string                           error;
+		};
+
+		typedef std::function<void(const Result &)> Callback;
+
+		static void                               importGeometry( const std::vector<std::string> &paths, Callback callback, sint64 memoryBudget = sint64(1) << 30, int numThreads = 0, bool triangulate = false ); // blocks until all files have been imported, callback is called on the calling thread in completion order, an exception thrown by the callback cancels the batch and is rethrown once all workers have finished
+		static sint64                             estimateMemory( const std::string &path ); // estimated peak memory for importing given file (three times its size)
+	};
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <houio/HouGeoAdapter.h>
+#include <houio/HouGeoIO.h>
+#include <houio/Geometry.h>
+#include <houio/Field.h>
+
+
+
+namespace houio
+{
+	// exports files on background threads so that the caller (e.g. a simulation loop) can continue while frames are encoded and written
+	// geometry and volumes are snapshotted without copying their attributes and voxels: these are shared copy on write (see Attribute::createView and Field::getData)
+	// and only get copied if the caller writes to them (through set, getRawPointer, lvalue etc.) before the export has finished
+	// the index buffer of geometry is copied when it is queued
+	// at most maxQueued exports wait for a thread, further calls to xport block until one has been started (backpressure)
+	struct HouGeoExportQueue
+	{
+		typedef std::shared_ptr<HouGeoExportQueue> Ptr;
+		typedef HouGeoIO::ExportOptions Options;
+
+		HouGeoExportQueue( int maxQueued = 1, int numThreads = 1 ); // defaults to double buffering: one frame is written while the next one waits
+		~HouGeoExportQueue(); // waits for all queued exports
+
+		static Ptr                                create( int maxQueued = 1, int numThreads = 1 );
+
+		std::future<bool>                         xport( const std::string &filename, HouGeoAdapter::Ptr geo, const Options &options = Options() ); // geo is taken over and must not be modified until the future is ready
+		std::future<bool>                         xport( const std::string &filename, Geometry::Ptr geo, const Options &options = Options() );
+		std::future<bool>                         xport( const std::string &filename, ScalarField::Ptr volume, const Options &options = Options() );
+
+		void                                      wait(); // blocks until all queued exports have been written
+		int                                       numPending()const; // exports which are queued or being written
+		double                                    getStallTime()const; // seconds xport has been blocked by a full queue in total
+
+	private:
+		std::future<bool>                         push( std::function<bool()> write ); // blocks while the queue is full
+		void                                      worker();
+
+		int                                       m_maxQueued;
+		mutable std::mutex                        m_mutex;
+		std::condition_variable                   m_queueCondition; // signaled when exports are queued or on shutdown
+		std::condition_variable                   m_spaceCondition; // signaled when an export has been taken from the queue
+		std::condition_variable                   m_idleCondition; // signaled when an export has been finished
+		std::deque<std::packaged_task<bool()>>    m_queue;
+		int                                       m_numRunning;
+		double                                    m_stallTime;
+		bool                                      m_stop;
+		std::vector<std::thread>                  m_threads;
+	};
+}
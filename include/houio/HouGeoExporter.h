@@ -0,0 +1,60 @@
+#pragma once
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <houio/HouGeoAdapter.h>
+#include <houio/HouGeoIO.h>
+#include <houio/json.h>
+
+
+
+namespace houio
+{
+	// writes geometry as binary (bgeo) or ascii (geo) json
+	// every exporter owns its writer and options, exporters can be used from different threads at the same time
+	// one exporter writes one file
+	struct HouGeoExporter
+	{
+		typedef std::shared_ptr<HouGeoExporter> Ptr;
+		typedef HouGeoIO::ExportOptions Options;
+
+		HouGeoExporter( json::OutputSink *sink, const Options &options = Options() ); // sink has to outlive the exporter
+		HouGeoExporter( std::ostream *out, const Options &options = Options() ); // writes through a StreamSink
+		~HouGeoExporter(); // flushes the sink, prints a warning if that fails
+
+		static Ptr                                create( json::OutputSink *sink, const Options &options = Options() );
+
+		bool                                      write( HouGeoAdapter::Ptr geo );
+		bool                                      flush(); // hands buffered output to the sink
+		const Options&                            getOptions()const;
+
+	private:
+		void                                      init( const Options &options );
+		bool                                      exportAttribute( HouGeoAdapter::AttributeAdapter::Ptr attr );
+		bool                                      exportTopology( HouGeoAdapter::Topology::Ptr topo );
+		bool                                      exportGroup( const std::string &name, BitSet::Ptr group, sint64 numElements );
+		bool                                      exportPrimitive( HouGeoAdapter::VolumePrimitive::Ptr volume );
+		bool                                      exportPrimitive( HouGeoAdapter::PolyPrimitive::Ptr poly );
+		template<typename T>
+		void                                      writePages( const T *data, sint64 numElements, int tupleSize, const std::vector<int> &packing, sint64 pageSize, bool constantPages );
+		template<typename T>
+		void                                      writeUniform( const T *data, sint64 numElements );
+		void                                      writeUniformBools( const uint32 *bits, sint64 numElements );
+
+		Options                                   m_options;
+		std::unique_ptr<json::Writer>             m_writer;
+		json::BinaryWriter                       *m_binaryWriter; // one of these equals m_writer
+		json::ASCIIWriter                        *m_asciiWriter;
+	};
+
+	template<typename T>
+	void HouGeoExporter::writeUniform( const T *data, sint64 numElements )
+	{
+		if( m_binaryWriter )
+			m_binaryWriter->jsonUniformArray<T>( data, numElements );
+		else
+			m_asciiWriter->jsonUniformArray<T>( data, numElements );
+	}
+}
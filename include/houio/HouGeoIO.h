@@ -1,31 +1,87 @@
 #pragma once
 #include <houio/HouGeo.h>
 #include <houio/Geometry.h>
+#include <houio/HouGeoIndex.h>
 
 
 namespace houio
 {
 	struct HouGeoIO
 	{
+		// counts and schema of a bgeo file as returned by probe
+		struct Metadata
+		{
+			struct AttributeInfo
+			{
+				std::string                     name;
+				std::string                     type; // numeric or string
+				std::string                     storage;
+				int                             tupleSize;
+			};
+
+			Metadata();
+
+			bool                                valid; // false if the file couldnt be parsed
+			sint64                              pointCount;
+			sint64                              vertexCount;
+			sint64                              primitiveCount;
+			std::vector<AttributeInfo>          pointAttributes;
+			std::vector<AttributeInfo>          vertexAttributes;
+			std::vector<AttributeInfo>          primitiveAttributes;
+			std::vector<AttributeInfo>          globalAttributes;
+			std::vector<std::string>            pointGroups;
+			std::vector<std::string>            primitiveGroups;
+			std::map<std::string, sint64>       primitiveTypes; // number of primitives per type (polygons of runs are counted individually)
+			std::vector<math::V3i>              volumeResolutions; // in the order of the volume primitives
+		};
+
+		// frame of a deforming sequence as returned by importFrame
+		struct SequenceFrame
+		{
+			typedef std::shared_ptr<SequenceFrame> Ptr;
+
+			SequenceFrame();
+
+			HouGeo::Ptr                         houGeo; // attribute data may be shared with the reference frame, it is copied once either frame writes to it (unchanged topology, polygons and groups are the objects of the reference frame and must not be modified)
+			std::map<std::string, std::pair<sint64, uint64>> signatures; // byte size and payload hash per topology, attribute, group and primitive (entries whose size changed against the reference have none)
+			sint64                              numShared; // number of entries taken from the reference frame
+			sint64                              numDecoded;
+		};
+
 		static HouGeo::Ptr                      import( std::istream *in );
-		static Geometry::Ptr                    importGeometry( const std::string &path );
+		static SequenceFrame::Ptr               importFrame( const std::string &path, SequenceFrame::Ptr reference = SequenceFrame::Ptr() ); // entries which are identical to the ones of reference are taken from it instead of decoded (polygon meshes and point clouds only)
+		static Geometry::Ptr                    importGeometry( const std::string &path, bool triangulate = false ); // polygon meshes with mixed vertex counts are always triangulated
+		static Geometry::Ptr                    importGeometry( HouGeo::Ptr houGeo, bool triangulate = false ); // converts the first poly primitive (or the points if there is no primitive)
 		static ScalarField::Ptr                 importVolume(const std::string &path);
+		static ScalarField::Ptr                 importVolume(const std::string &path, const math::Box3f &region, bool voxelSpace = false ); // loads the part of the volume which intersects given region (only intersecting tiles are decoded, for binary files only those are read)
+		static ScalarField::Ptr                 importVolume(const std::string &path, const std::string &name ); // loads the volume with given name (other volumes are not decoded)
+		static HouGeo::Ptr                      importVolumes(const std::string &path, std::vector<HouGeo::HouVolume::Ptr>& volumes ); // volumes decode their voxels on first call to getField
 		static void                             makeLog( const std::string &path, std::ostream *out );
+		// controls how exported data is encoded
+		struct ExportOptions
+		{
+			ExportOptions();
+
+			bool                                constantTiles; // volume tiles whose voxels are all equal are written as a single value
+			real32                              tolerance; // with constantTiles, tiles whose values lie within tolerance are written as constant too (center of their range)
+			bool                                halfPrecisionTiles; // non-constant volume tiles are written as fpreal16
+			bool                                constantPages; // packs of numeric attributes which are the same for all elements of a page are written once (constantpageflags)
+			bool                                splitPacking; // attributes with 4 components (e.g. P) are written as packs of 3+1, so that a constant w collapses
+			bool                                binary; // false writes ascii json (geo)
+			bool                                internStrings; // repeated strings of binary output go through the string table (off by default)
+			bool                                polygonRuns; // closed polygons with sequentially numbered vertices are written as Polygon_run (Houdini 13 and later, off by default)
+		};
 
-		static Geometry::Ptr                    convertToGeometry(HouGeo::Ptr houGeo, HouGeoAdapter::Primitive::Ptr houPrim ); // converts primitive with the given index to geometry
+		static Metadata                         probe( const std::string &path, HouGeoIndex::Ptr index = HouGeoIndex::Ptr() ); // reads counts and schema only, uniform arrays are skipped without being read (optionally fills given index)
 
-		static bool                             xport( const std::string& filename, ScalarField::Ptr volume ); // convinience funcion for quickly saving volume to bgeo
-		static bool                             xport( const std::string& filename, Geometry::Ptr geo ); // convinience funcion for quickly saving geometry to bgeo
+		static Geometry::Ptr                    convertToGeometry(HouGeo::Ptr houGeo, HouGeoAdapter::Primitive::Ptr houPrim, bool triangulate = false ); // converts primitive with the given index to geometry
+
+		static bool                             xport( const std::string& filename, ScalarField::Ptr volume, const ExportOptions &options = ExportOptions() ); // convinience funcion for quickly saving volume to bgeo
+		static bool                             xport( const std::string& filename, Geometry::Ptr geo, const ExportOptions &options = ExportOptions() ); // convinience funcion for quickly saving geometry to bgeo
 		static bool                             xport( const std::string& filename, const std::vector<math::V3f>& points );
 		static bool                             xport( const std::string& filename, const std::map<std::string, std::vector<math::V3f>>& pattr_v3f );
+		static bool                             xport( const std::string& filename, HouGeoAdapter::Ptr geo, bool useMmap = false, const ExportOptions &options = ExportOptions() ); // writes through a json::FileSink
 		static bool                             xport( std::ostream *out, HouGeoAdapter::Ptr geo , bool binary = true);
-
-	private:
-		static bool                             exportAttribute( HouGeoAdapter::AttributeAdapter::Ptr attr );
-		static bool                             exportTopology( HouGeoAdapter::Topology::Ptr topo );
-		static bool                             exportPrimitive( HouGeoAdapter::VolumePrimitive::Ptr volume );
-		static bool                             exportPrimitive( HouGeoAdapter::PolyPrimitive::Ptr poly );
-		static HouGeoAdapter*                   g_geo;
-		static json::BinaryWriter*              g_writer;
+		static bool                             xport( json::OutputSink *sink, HouGeoAdapter::Ptr geo, const ExportOptions &options = ExportOptions() ); // see HouGeoExporter, safe to call from multiple threads
 	};
 }
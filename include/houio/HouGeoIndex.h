@@ -0,0 +1,77 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <houio/HouGeo.h>
+#include <houio/json.h>
+
+
+
+namespace houio
+{
+	// byte offsets of the bulk data in a binary bgeo file
+	// allows to parse single attributes, groups, primitives or volume tiles without scanning the whole file
+	// the index is built during HouGeoIO::probe and can be stored next to the bgeo file (path + ".idx")
+	struct HouGeoIndex
+	{
+		typedef std::shared_ptr<HouGeoIndex> Ptr;
+
+		enum EntryType
+		{
+			ENTRY_TOPOLOGY = 0,
+			ENTRY_POINT_ATTRIBUTE = 1,
+			ENTRY_VERTEX_ATTRIBUTE = 2,
+			ENTRY_PRIMITIVE_ATTRIBUTE = 3,
+			ENTRY_GLOBAL_ATTRIBUTE = 4,
+			ENTRY_PRIMITIVE = 5,
+			ENTRY_VOLUME_TILE = 6,
+			ENTRY_POINT_GROUP = 7,
+			ENTRY_PRIMITIVE_GROUP = 8
+		};
+
+		struct Entry
+		{
+			EntryType                             type;
+			std::string                           name; // attribute name, group name or primitive type
+			sint64                                primitive; // primitive index for primitives and volume tiles
+			sint64                                tile; // tile index within the volume for volume tiles
+			sint64                                offset; // byte range of the json array
+			sint64                                size;
+			sint64                                dataOffset; // byte range of the uniform array payload (rawpagedata, topology indices or tile data), -1 if there is none
+			sint64                                dataSize;
+			sint64                                numStringDefinitions; // number of string table definitions which precede the entry
+		};
+
+		HouGeoIndex();
+
+		static Ptr                                create();
+		static Ptr                                build( const std::string &path ); // scans the file once (throws for ascii files)
+		static Ptr                                load( const std::string &path, bool writeSidecar = true ); // reads the sidecar index or builds (and writes) it if it is missing or outdated
+		static std::string                        sidecarPath( const std::string &path );
+		static bool                               isIndexable( const std::string &path ); // only binary files can be indexed, offsets within ascii files would depend on formatting
+
+		bool                                      write( const std::string &indexPath )const;
+		static Ptr                                read( const std::string &indexPath );
+
+		const Entry*                              find( EntryType type, const std::string &name )const; // returns 0 if there is no such entry
+		void                                      getEntries( EntryType type, std::vector<const Entry*> &entries )const;
+
+		json::Value                               parseEntry( std::istream *in, const Entry &entry )const; // parses the json array of given entry
+		json::Value                               parseEntry( const char *data, const Entry &entry )const; // parses the json array of given entry from its bytes (entry.size bytes read from entry.offset)
+		HouGeo::HouAttribute::Ptr                 loadAttribute( std::istream *in, EntryType type, const std::string &name )const; // returns 0 if the attribute doesnt exist
+		HouGeo::Ptr                               loadPrimitives( std::istream *in, sint64 first, sint64 count )const; // loads topology, point attributes and the given range of the primitives array (volumes with shared voxels are not supported)
+		void                                      loadTiles( std::istream *in, sint64 primitive, const std::vector<sint64> &tiles, std::vector<json::ArrayPtr> &result )const; // parses the given tiles of a volume primitive, throws if a tile doesnt exist
+		static HouGeo::TileLoader                 tileLoader( Ptr index, std::shared_ptr<std::istream> in ); // parses volume tiles on demand (see HouGeo::setTileLoader)
+
+		sint64                                    fileSize; // size and modification time (nanoseconds) of the indexed file
+		sint64                                    fileTime;
+		sint64                                    fileHash; // hash of the first and last block of the indexed file
+		sint64                                    pointCount;
+		sint64                                    vertexCount;
+		sint64                                    primitiveCount;
+		std::vector<Entry>                        entries;
+		std::vector<std::pair<sint64, std::string>> stringDefinitions; // string table definitions in the order they appear in the file
+	};
+}
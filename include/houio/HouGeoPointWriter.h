@@ -0,0 +1,59 @@
+#pragma once
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <houio/HouGeoAdapter.h>
+#include <houio/json.h>
+
+
+
+namespace houio
+{
+	// writes point clouds to bgeo without holding the attribute data in memory
+	// the point count and the attributes are declared up front, the data is then written in chunks of points
+	// (ideally multiples of pageSize) which go straight into the rawpagedata of the respective attribute
+	// the output stream has to be seekable
+	struct HouGeoPointWriter
+	{
+		typedef std::shared_ptr<HouGeoPointWriter> Ptr;
+		typedef HouGeoAdapter::AttributeAdapter::Storage Storage;
+		static const int pageSize = 1024;
+
+		HouGeoPointWriter( std::ostream *out, sint64 numPoints );
+		HouGeoPointWriter( const std::string &filename, sint64 numPoints );
+		~HouGeoPointWriter();
+
+		static Ptr                                create( const std::string &filename, sint64 numPoints );
+
+		int                                       addAttribute( const std::string &name, int tupleSize, Storage storage = HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32 ); // returns attribute index, P with 3 components is written as 4 component P
+		int                                       getAttributeIndex( const std::string &name )const; // returns -1 if attribute doesnt exist
+
+		void                                      write( int attribute, sint64 firstPoint, sint64 numPoints, const void *data ); // data holds numPoints tuples with the declared size and storage
+		bool                                      finish(); // returns false if not all points have been written
+
+	private:
+		struct AttributeInfo
+		{
+			std::string                           name;
+			int                                   tupleSize; // as given by the user
+			int                                   fileTupleSize; // as written to the file
+			Storage                               storage;
+			std::streamoff                        payload; // stream position of the first element in rawpagedata
+			sint64                                numPointsWritten;
+		};
+
+		void                                      writeHeader();
+		void                                      writeAttribute( AttributeInfo &attr );
+
+		std::unique_ptr<std::ofstream>            m_file;
+		std::ostream                             *m_out;
+		std::unique_ptr<json::BinaryWriter>       m_writer;
+		sint64                                    m_numPoints;
+		std::vector<AttributeInfo>                m_attributes;
+		std::streamoff                            m_end; // stream position after the last byte of the file
+		bool                                      m_headerWritten;
+		bool                                      m_finished;
+	};
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <houio/HouGeo.h>
+#include <houio/HouGeoIO.h>
+#include <houio/Geometry.h>
+#include <houio/Field.h>
+
+
+
+namespace houio
+{
+	// reads animated bgeo sequences (e.g. "name.$F4.bgeo")
+	// the frames following the most recently requested frame (in playback direction) are loaded ahead of time
+	// by worker threads and decoded frames are kept in a LRU cache which is bounded by a byte budget
+	struct HouGeoSequence
+	{
+		typedef std::shared_ptr<HouGeoSequence> Ptr;
+
+		// determines what is decoded from each file
+		enum Content
+		{
+			CONTENT_HOUGEO = 0,
+			CONTENT_GEOMETRY = 1,
+			CONTENT_VOLUME = 2
+		};
+
+		struct Frame
+		{
+			HouGeo::Ptr                           houGeo; // only one of these is set, depending on content
+			Geometry::Ptr                         geometry;
+			ScalarField::Ptr                      volume;
+		};
+
+		struct Stats
+		{
+			Stats();
+
+			sint64                                hits; // frame was in the cache or being prefetched
+			sint64                                misses; // frame had to be loaded by the caller
+			sint64                                stalls; // requests which had to wait for a frame (misses and unfinished prefetches)
+			double                                stallTime; // seconds spent waiting in total
+			sint64                                prefetches; // frames loaded by the worker threads
+			sint64                                evictions;
+			sint64                                bytes; // estimated memory held by the cache
+			sint64                                numFrames; // frames held by the cache
+			sint64                                sharedEntries; // topology, attributes, groups and primitives taken from a previous frame (see setTopologyReuse)
+			sint64                                decodedEntries;
+		};
+
+		HouGeoSequence( const std::string &pattern, int firstFrame, int lastFrame, Content content = CONTENT_HOUGEO, int numPrefetch = 4, sint64 byteBudget = sint64(1) << 30, int numThreads = 2 );
+		~HouGeoSequence();
+
+		static Ptr                                create( const std::string &pattern, int firstFrame, int lastFrame, Content content = CONTENT_HOUGEO, int numPrefetch = 4, sint64 byteBudget = sint64(1) << 30, int numThreads = 2 );
+		static std::string                        framePath( const std::string &pattern, int frame ); // replaces $F and $F<padding> (e.g. $F4) with the frame number
+
+		Frame                                     get( int frame ); // blocks until the frame is available, returns an empty frame if the frame is out of range or failed to load (failed loads are retried on the next request)
+		HouGeo::Ptr                               getHouGeo( int frame );
+		Geometry::Ptr                             getGeometry( int frame );
+		ScalarField::Ptr                          getVolume( int frame );
+
+		void                                      setTopologyReuse( bool reuse ); // frames are imported with HouGeoIO::importFrame, sharing unchanged data with the most recently loaded frame (HouGeo and Geometry content)
+
+		Stats                                     getStats()const;
+		void                                      resetStats(); // cache size is kept
+		void                                      clear(); // drops all cached frames
+
+		int                                       firstFrame()const;
+		int                                       lastFrame()const;
+
+	private:
+		enum State
+		{
+			STATE_QUEUED,
+			STATE_LOADING,
+			STATE_LOADED
+		};
+
+		struct Entry
+		{
+			State                                 state;
+			Frame                                 frame;
+			sint64                                bytes;
+			std::list<int>::iterator              lru; // valid if loaded
+		};
+
+		Frame                                     load( int frame, sint64 &bytes ); // bytes receives the estimated memory size, called without the lock
+		HouGeo::Ptr                               importHouGeo( const std::string &path ); // called without the lock
+		static sint64                             memorySize( const Frame &frame, const std::string &path );
+		void                                      loaded( int frame, const Frame &data, sint64 bytes ); // empty frames are dropped, expects the lock to be held
+		void                                      touch( int frame ); // moves frame to the front of the lru list, expects the lock to be held
+		void                                      schedule( int frame ); // updates the prefetch queue, expects the lock to be held
+		void                                      evict(); // expects the lock to be held
+		void                                      worker();
+
+		std::string                               m_pattern;
+		int                                       m_firstFrame;
+		int                                       m_lastFrame;
+		Content                                   m_content;
+		int                                       m_numPrefetch;
+		sint64                                    m_byteBudget;
+		bool                                      m_reuseTopology;
+
+		mutable std::mutex                        m_mutex;
+		std::condition_variable                   m_queueCondition; // signaled when frames are queued or on shutdown
+		std::condition_variable                   m_loadedCondition; // signaled when a frame has been loaded
+		std::map<int, Entry>                      m_entries;
+		std::list<int>                            m_lru; // most recently used first
+		std::deque<int>                           m_queue; // frames to prefetch, in order
+		int                                       m_lastRequested;
+		Stats                                     m_stats;
+		HouGeoIO::SequenceFrame::Ptr              m_reference; // most recently imported frame if topology is reused
+		bool                                      m_stop;
+		std::vector<std::thread>                  m_threads;
+	};
+}
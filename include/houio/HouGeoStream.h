@@ -0,0 +1,50 @@
+#pragma once
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <houio/HouGeoAdapter.h>
+
+
+
+namespace houio
+{
+	// streaming import of binary bgeo files
+	// point and vertex attribute data is handed to a handler as page sized blocks while the file is parsed
+	// the geometry is never held in memory, only a single page of the current attribute is buffered
+	struct HouGeoStream
+	{
+		typedef HouGeoAdapter::AttributeAdapter::Storage Storage;
+
+		enum Owner
+		{
+			OWNER_POINT = 0,
+			OWNER_VERTEX = 1
+		};
+
+		struct Block
+		{
+			std::string                           name;
+			Owner                                 owner;
+			Storage                               storage;
+			int                                   tupleSize;
+			sint64                                firstElement;
+			sint64                                numElements;
+			const void                           *data; // numElements tuples (components are interleaved) with given storage
+		};
+
+		struct Handler
+		{
+			virtual                              ~Handler();
+			virtual void                          counts( sint64 pointCount, sint64 vertexCount, sint64 primitiveCount ); // called before the first attribute
+			virtual bool                          attribute( const std::string &name, Owner owner, Storage storage, int tupleSize ); // return false to skip the data of the attribute
+			virtual void                          block( const Block &block )=0; // the data pointer is only valid during the call
+		};
+
+		typedef std::function<void(const Block &)> BlockCallback;
+
+		static bool                               read( std::istream *in, Handler *handler );
+		static bool                               read( const std::string &path, Handler *handler );
+		static bool                               read( const std::string &path, BlockCallback callback );
+	};
+}
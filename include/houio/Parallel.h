@@ -0,0 +1,43 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <houio/types.h>
+
+
+
+namespace houio
+{
+	// splits the range [begin, end) into contiguous chunks which are processed concurrently
+	// f is called with (chunkBegin, chunkEnd) and must not throw
+	// ranges smaller than grainSize are processed on the calling thread
+	template<typename F>
+	void parallelFor( sint64 begin, sint64 end, F f, sint64 grainSize = 4096 )
+	{
+		sint64 count = end - begin;
+		if( count <= 0 )
+			return;
+
+		sint64 numThreads = std::max<sint64>( 1, std::thread::hardware_concurrency() );
+		numThreads = std::min<sint64>( numThreads, (count + grainSize - 1)/grainSize );
+		if( numThreads <= 1 )
+		{
+			f( begin, end );
+			return;
+		}
+
+		sint64 chunkSize = (count + numThreads - 1)/numThreads;
+		std::vector<std::thread> threads;
+		threads.reserve( numThreads-1 );
+		for( sint64 chunkBegin = begin + chunkSize; chunkBegin < end; chunkBegin += chunkSize )
+			threads.push_back( std::thread( f, chunkBegin, std::min( chunkBegin + chunkSize, end ) ) );
+
+		// first chunk is done on the calling thread
+		f( begin, std::min( begin + chunkSize, end ) );
+
+		for( auto &thread:threads )
+			thread.join();
+	}
+
+} // namespace houio
@@ -25,8 +25,12 @@
 #include <stack>
 #include <memory>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 #include <houio/types.h>
 #include <ttl/var/variant.hpp>
@@ -40,7 +44,7 @@ namespace houio
 	{
 		struct Parser;
 
-		// note: currently all different int types (sint32, sint64 etc. will be routed to jsonInt32)
+		// note: all int types up to 32bit are routed to jsonInt32, sint64 goes to jsonInt64
 		struct Handler
 		{
 			virtual void                               jsonBeginArray() = 0;
@@ -51,17 +55,113 @@ namespace houio
 			virtual void              jsonKey( const std::string &key ) = 0;
 			virtual void                  jsonBool( const bool &value ) = 0;
 			virtual void               jsonInt32( const sint32 &value ) = 0;
+			virtual void               jsonInt64( const sint64 &value ); // narrowed and passed to jsonInt32 by default
 			virtual void              jsonReal32( const real32 &value ) = 0;
 			virtual void   uaBool( sint64 numElements, Parser *parser ) = 0;
+			virtual void uaReal16( sint64 numElements, Parser *parser ); // widened and passed to uaReal32 by default
 			virtual void uaReal32( sint64 numElements, Parser *parser ) = 0;
 			virtual void uaReal64( sint64 numElements, Parser *parser ) = 0;
+			virtual void   uaInt8( sint64 numElements, Parser *parser ); // widened and passed to uaInt32 by default
 			virtual void  uaInt16( sint64 numElements, Parser *parser ) = 0;
 			virtual void  uaInt32( sint64 numElements, Parser *parser ) = 0;
 			virtual void  uaInt64( sint64 numElements, Parser *parser ) = 0;
 			virtual void  uaUInt8( sint64 numElements, Parser *parser ) = 0;
+			virtual void uaUInt16( sint64 numElements, Parser *parser ); // widened and passed to uaInt32 by default
 			virtual void uaString( sint64 numElements, Parser *parser ) = 0;
+			virtual void stringDefinition( sint64, const std::string & ){} // called for every entry added to the string table
 		};
 
+		// handler which keeps track of the containers which are currently being parsed
+		// bgeo stores most objects as arrays of alternating keys and values, those are tracked like maps
+		// Frame has to derive from KeyValueFrame and is what derived handlers attach their state to
+		struct KeyValueFrame
+		{
+			bool                                                isMap;
+			sint64                                              index; // number of completed elements
+			std::string                                         key; // most recent key
+
+			bool isValue()const{return isMap || (index & 1);} // next element is the value of a key/value pair
+		};
+
+		template<typename Frame>
+		struct KeyValueHandler : public Handler
+		{
+			virtual void beginFrame( Frame &frame, const Frame *parent, const std::string &key ) = 0; // container is about to be pushed, key is the key it is the value of (or empty)
+			virtual void endFrame( const Frame & ){} // container has been popped
+			virtual void value( Frame &frame, const std::string *string, sint64 intValue, bool boolValue ) = 0; // element which is neither a container nor a key
+
+			void nextElement(); // completes an element of the current container (uniform arrays have to call this)
+
+			virtual void jsonBeginArray()override{beginContainer( false );}
+			virtual void jsonEndArray()override{endContainer();}
+			virtual void jsonBeginMap()override{beginContainer( true );}
+			virtual void jsonEndMap()override{endContainer();}
+			virtual void jsonString( const std::string &v )override{element( &v, 0, false );}
+			virtual void jsonKey( const std::string &key )override;
+			virtual void jsonBool( const bool &v )override{element( 0, v, v );}
+			virtual void jsonInt32( const sint32 &v )override{element( 0, v, v != 0 );}
+			virtual void jsonReal32( const real32 &v )override{element( 0, sint64(v), v != 0.0f );}
+
+			std::vector<Frame>                                m_frames;
+
+		private:
+			void                         beginContainer( bool isMap );
+			void                                     endContainer();
+			void element( const std::string *string, sint64 intValue, bool boolValue );
+		};
+
+		template<typename Frame>
+		void KeyValueHandler<Frame>::nextElement()
+		{
+			if( !m_frames.empty() )
+				++m_frames.back().index;
+		}
+
+		template<typename Frame>
+		void KeyValueHandler<Frame>::jsonKey( const std::string &key )
+		{
+			if( !m_frames.empty() )
+				m_frames.back().key = key;
+		}
+
+		template<typename Frame>
+		void KeyValueHandler<Frame>::beginContainer( bool isMap )
+		{
+			Frame frame = Frame();
+			frame.isMap = isMap;
+			frame.index = 0;
+			if( m_frames.empty() )
+				beginFrame( frame, 0, "" );
+			else
+			{
+				const Frame &parent = m_frames.back();
+				beginFrame( frame, &parent, parent.isValue() ? parent.key : "" );
+			}
+			m_frames.push_back( frame );
+		}
+
+		template<typename Frame>
+		void KeyValueHandler<Frame>::endContainer()
+		{
+			Frame frame = m_frames.back();
+			m_frames.pop_back();
+			endFrame( frame );
+			nextElement();
+		}
+
+		template<typename Frame>
+		void KeyValueHandler<Frame>::element( const std::string *string, sint64 intValue, bool boolValue )
+		{
+			if( m_frames.empty() )
+				return;
+			Frame &frame = m_frames.back();
+			if( string && !frame.isValue() )
+				frame.key = *string;
+			else
+				value( frame, string, intValue, boolValue );
+			++frame.index;
+		}
+
 
 		struct Token
 		{
@@ -142,6 +242,52 @@ namespace houio
 			stream << t;
 			return stream.str();
 		}
+
+		// allocation free number formatting, buffer has to hold at least maxNumberLength characters
+		// returns the number of characters written (no terminating zero)
+		// reals are printed with the shortest digit sequence which reads back to the same value (grisu2) and
+		// always contain a '.' or an exponent so that they are read back as reals
+		static const int                          maxNumberLength = 32;
+		int                                       formatInt( sint64 value, char *buffer );
+		int                                       formatReal( real32 value, char *buffer );
+		int                                       formatReal( real64 value, char *buffer );
+
+		// used by the uniform array writers
+		inline int formatValue( sbyte value, char *buffer ){ return formatInt( value, buffer ); }
+		inline int formatValue( ubyte value, char *buffer ){ return formatInt( value, buffer ); }
+		inline int formatValue( sword value, char *buffer ){ return formatInt( value, buffer ); }
+		inline int formatValue( uword value, char *buffer ){ return formatInt( value, buffer ); }
+		inline int formatValue( sint32 value, char *buffer ){ return formatInt( value, buffer ); }
+		inline int formatValue( sint64 value, char *buffer ){ return formatInt( value, buffer ); }
+		inline int formatValue( const real16 &value, char *buffer ){ return formatReal( real32(value), buffer ); }
+		inline int formatValue( real32 value, char *buffer ){ return formatReal( value, buffer ); }
+		inline int formatValue( real64 value, char *buffer ){ return formatReal( value, buffer ); }
+
+		template<>
+		inline std::string toString<sint32>(const sint32& t)
+		{
+			char buffer[maxNumberLength];
+			return std::string( buffer, formatInt( t, buffer ) );
+		}
+		template<>
+		inline std::string toString<sint64>(const sint64& t)
+		{
+			char buffer[maxNumberLength];
+			return std::string( buffer, formatInt( t, buffer ) );
+		}
+		template<>
+		inline std::string toString<real32>(const real32& t)
+		{
+			char buffer[maxNumberLength];
+			return std::string( buffer, formatReal( t, buffer ) );
+		}
+		template<>
+		inline std::string toString<real64>(const real64& t)
+		{
+			char buffer[maxNumberLength];
+			return std::string( buffer, formatReal( t, buffer ) );
+		}
+
 		template<class T>
 		inline std::string toString(const T& t, int precision)
 		{
@@ -151,6 +297,15 @@ namespace houio
 			return stream.str();
 		}
 
+		// exposes a block of memory as the stream of a parser
+		struct MemoryBuffer : public std::streambuf
+		{
+			MemoryBuffer( char *data, size_t size )
+			{
+				setg( data, data, data + size );
+			}
+		};
+
 		// Parser ==================================================
 		struct Parser
 		{
@@ -171,6 +326,7 @@ namespace houio
 			};
 
 			bool parse( std::istream *in,  Handler *h );
+			bool parseValue( std::istream *in, Handler *h ); // parses the binary array or map at the current stream position (strings has to hold the string table of that position)
 			bool                          parseStream();
 			bool                  readToken( Token &t );
 			bool            readBinaryToken( Token &t, ubyte test = -1 );
@@ -237,9 +393,88 @@ namespace houio
 			virtual void      jsonReal64( const real64 &value ) = 0;
 		};
 
+		// OutputSink ==============================================
+		// destination of the BinaryWriter, small writes are gathered in [m_cur, m_end) and handed
+		// to the device in large blocks, blocks which dont fit go to overflow
+		struct OutputSink
+		{
+			virtual                                  ~OutputSink(){}
+
+			bool                                      write( const char *data, sint64 size );
+			sint64                                    tell()const; // number of bytes written so far
+			virtual bool                              flush() = 0; // hands all buffered bytes to the device
+
+		protected:
+			OutputSink();
+			virtual bool                              overflow( const char *data, sint64 size ) = 0; // called for data which doesnt fit into the remaining buffer
+
+			char                                     *m_begin;
+			char                                     *m_cur;
+			char                                     *m_end;
+			sint64                                    m_base; // output position of m_begin
+		};
+
+		inline bool OutputSink::write( const char *data, sint64 size )
+		{
+			if( size <= m_end - m_cur )
+			{
+				memcpy( m_cur, data, size_t(size) );
+				m_cur += size;
+				return true;
+			}
+			return overflow( data, size );
+		}
+
+		inline sint64 OutputSink::tell()const
+		{
+			return m_base + (m_cur - m_begin);
+		}
+
+		// buffers writes to a std::ostream
+		struct StreamSink : public OutputSink
+		{
+			StreamSink( std::ostream *out, sint64 bufferSize = 1 << 20 );
+			virtual                                  ~StreamSink();
+			virtual bool                              flush()override;
+
+		protected:
+			virtual bool                              overflow( const char *data, sint64 size )override;
+
+			std::ostream                             *m_out;
+			std::vector<char>                         m_buffer;
+		};
+
+		// writes to a file without going through iostreams
+		// blocks larger than the buffer are written together with the buffered bytes in one gathered write (no copy)
+		// with useMmap the file is mapped and written to directly, the mapping grows by doubling (starting at preallocate)
+		// preallocate reserves disk space up front, the file is truncated to the written size on close
+		struct FileSink : public OutputSink
+		{
+			FileSink( const std::string &path, sint64 bufferSize = 4 << 20, bool useMmap = false, sint64 preallocate = 0 );
+			virtual                                  ~FileSink(); // closes the file
+			bool                                      isOpen()const;
+			bool                                      close();
+			virtual bool                              flush()override;
+
+		protected:
+			virtual bool                              overflow( const char *data, sint64 size )override;
+			bool                                      writeDevice( const char *buffered, sint64 bufferedSize, const char *data, sint64 size );
+			bool                                      map( sint64 size ); // (re)maps the first size bytes of the file, failure is left to the caller (the constructor falls back to buffered writes)
+
+			int                                       m_fd;
+			std::FILE                                *m_file; // used where posix io isnt available
+			bool                                      m_useMmap;
+			char                                     *m_mapping;
+			sint64                                    m_mappingSize;
+			bool                                      m_failed;
+			std::vector<char>                         m_buffer;
+		};
+
 		struct BinaryWriter : public Writer
 		{
-			BinaryWriter( std::ostream *out );
+			BinaryWriter( std::ostream *out ); // writes through a StreamSink
+			BinaryWriter( OutputSink *sink ); // sink has to outlive the writer
+			virtual                                      ~BinaryWriter(); // flushes the sink
 
 			bool jsonMagic();
 			virtual void                               jsonBeginArray()override;
@@ -263,6 +498,10 @@ namespace houio
 			bool                 jsonUniformArray( const std::vector<T> &data );
 			template<typename T>
 			bool          jsonUniformArray( const T *data, sint64 numElements );
+			bool jsonUniformBoolArray( const uint32 *bits, sint64 numElements ); // writes bitstream (32 bits per word, lsb first)
+			bool jsonBeginUniformArray( Token::Type type, sint64 numElements ); // writes the uniform array header only, the elements have to follow
+			template<typename T>
+			static Token::Type                                    uniformType(); // element type of uniform arrays of T
 
 			bool                                      writeId( Token::Type id );
 			bool                            writeLength( const sint64 &length );
@@ -273,53 +512,64 @@ namespace houio
 			template<typename T>
 			bool                      write( const T *dst, sint64 numElements );
 
+			bool                                                     flush(); // hands buffered output to the underlying stream or file
+			void                             setStringInterning( bool intern ); // strings which occur repeatedly are written once into the string table (JID_TOKENDEF) and then referenced (JID_TOKENREF)
 
 
 			// 
-			std::ostream                                                *stream;
+			OutputSink                                                    *sink;
+		private:
+			static const size_t                                      maxInternedLength = 64; // longer strings are always written inline
+			static const size_t                                      maxInternedStrings = 1 << 16;
+
+			std::unique_ptr<OutputSink>                              m_ownedSink;
+			bool                                                     m_internStrings;
+			std::unordered_map<std::string, sint64>                  m_stringIds; // -1 for strings which have been written once
+			sint64                                                   m_numStringIds;
 		};
 
 		template<typename T>
 		bool BinaryWriter::write( const T &v )
 		{
-			stream->write( (const char *)&v, sizeof(T) );
-			return true;
+			return sink->write( (const char *)&v, sizeof(T) );
 		}
 		template<typename T>
 		bool BinaryWriter::write( const T *dst, sint64 numElements )
 		{
-			stream->write( (const char *)dst, numElements*sizeof(T) );
-			return true;
+			return sink->write( (const char *)dst, numElements*sizeof(T) );
 		}
 
 		template<typename T>
-		bool BinaryWriter::jsonUniformArray( const std::vector<T> &data )
+		Token::Type BinaryWriter::uniformType()
 		{
-			Token::Type type = Token::JID_NULL;
-			if( typeid(T) == typeid(real32) )
-				type = Token::JID_REAL32;
+			if( typeid(T) == typeid(real16) )
+				return Token::JID_REAL16;
+			else if( typeid(T) == typeid(real32) )
+				return Token::JID_REAL32;
 			else if( typeid(T) == typeid(real64) )
-				type = Token::JID_REAL64;
+				return Token::JID_REAL64;
 			else if( typeid(T) == typeid(bool) )
-				type = Token::JID_BOOL;
+				return Token::JID_BOOL;
 			else if( typeid(T) == typeid(sbyte) )
-				type = Token::JID_INT8;
+				return Token::JID_INT8;
 			else if( typeid(T) == typeid(sword) )
-				type = Token::JID_INT16;
+				return Token::JID_INT16;
 			else if( typeid(T) == typeid(sint32) )
-				type = Token::JID_INT32;
+				return Token::JID_INT32;
 			else if( typeid(T) == typeid(sint64) )
-				type = Token::JID_INT64;
+				return Token::JID_INT64;
 			else if( typeid(T) == typeid(ubyte) )
-				type = Token::JID_UINT8;
+				return Token::JID_UINT8;
 			else if( typeid(T) == typeid(uword) )
-				type = Token::JID_UINT16;
-			else
-				throw std::runtime_error("BinaryWriter::jsonUniformArray: unable to handle type");
-			
-			writeId( Token::JID_UNIFORM_ARRAY );
-			write<sbyte>( (sbyte)type );
-			writeLength( data.size() );
+				return Token::JID_UINT16;
+			throw std::runtime_error("BinaryWriter::jsonUniformArray: unable to handle type");
+		}
+
+		template<typename T>
+		bool BinaryWriter::jsonUniformArray( const std::vector<T> &data )
+		{
+			Token::Type type = uniformType<T>();
+			jsonBeginUniformArray( type, data.size() );
 			if( !data.empty() )
 				write<T>( &data[0], data.size() );
 
@@ -328,31 +578,8 @@ namespace houio
 		template<typename T>
 		bool BinaryWriter::jsonUniformArray( const T *data, sint64 numElements )
 		{
-			Token::Type type = Token::JID_NULL;
-			if( typeid(T) == typeid(real32) )
-				type = Token::JID_REAL32;
-			else if( typeid(T) == typeid(real64) )
-				type = Token::JID_REAL64;
-			else if( typeid(T) == typeid(bool) )
-				type = Token::JID_BOOL;
-			else if( typeid(T) == typeid(sbyte) )
-				type = Token::JID_INT8;
-			else if( typeid(T) == typeid(sword) )
-				type = Token::JID_INT16;
-			else if( typeid(T) == typeid(sint32) )
-				type = Token::JID_INT32;
-			else if( typeid(T) == typeid(sint64) )
-				type = Token::JID_INT64;
-			else if( typeid(T) == typeid(ubyte) )
-				type = Token::JID_UINT8;
-			else if( typeid(T) == typeid(uword) )
-				type = Token::JID_UINT16;
-			else
-				throw std::runtime_error("BinaryWriter::jsonUniformArray: unable to handle type");
-			
-			writeId( Token::JID_UNIFORM_ARRAY );
-			write<sbyte>( (sbyte)type );
-			writeLength( numElements );
+			Token::Type type = uniformType<T>();
+			jsonBeginUniformArray( type, numElements );
 			write<T>( data, numElements );
 
 			return true;
@@ -360,9 +587,12 @@ namespace houio
 
 
 		// ASCIIWriter ==================================================
+		// numbers are formatted into a stack buffer (see formatInt/formatReal) and copied into the buffer of the sink
 		struct ASCIIWriter : public Writer
 		{
-			ASCIIWriter( std::ostream *out );
+			ASCIIWriter( std::ostream *out ); // writes through a StreamSink
+			ASCIIWriter( OutputSink *sink ); // sink has to outlive the writer
+			virtual                                       ~ASCIIWriter(); // flushes the sink
 
 			virtual void                               jsonBeginArray()override;
 			virtual void                                 jsonEndArray()override;
@@ -380,8 +610,19 @@ namespace houio
 			virtual void              jsonReal32( const real32 &value )override;
 			virtual void              jsonReal64( const real64 &value )override;
 
+			// uniform arrays are written in one go on a single line
+			template<typename T>
+			bool                 jsonUniformArray( const std::vector<T> &data );
+			template<typename T>
+			bool          jsonUniformArray( const T *data, sint64 numElements );
+			bool jsonUniformBoolArray( const uint32 *bits, sint64 numElements ); // reads bitstream (32 bits per word, lsb first)
+
+			bool                                                     flush(); // hands buffered output to the underlying stream or file
 
+			void                                       write( const char *text, sint64 size );
 			void                               write( const std::string &text );
+			template<typename T>
+			void                                        writeNumber( T value );
 
 			void                                                 writeNewline();
 			void                                                  writePrefix();
@@ -392,9 +633,48 @@ namespace houio
 			std::stack<Token::Type>                                       stack;
 			std::string                                                  prefix;
 			// 
-			std::ostream                                                *stream;
+			OutputSink                                                    *sink;
+		private:
+			std::unique_ptr<OutputSink>                              m_ownedSink;
 		};
 
+		inline void ASCIIWriter::write( const char *text, sint64 size )
+		{
+			sink->write( text, size );
+		}
+
+		inline void ASCIIWriter::write( const std::string &text )
+		{
+			sink->write( text.c_str(), text.size() );
+		}
+
+		template<typename T>
+		void ASCIIWriter::writeNumber( T value )
+		{
+			char buffer[maxNumberLength];
+			sink->write( buffer, formatValue( value, buffer ) );
+		}
+
+		template<typename T>
+		bool ASCIIWriter::jsonUniformArray( const std::vector<T> &data )
+		{
+			return jsonUniformArray<T>( data.empty() ? 0 : &data[0], sint64(data.size()) );
+		}
+
+		template<typename T>
+		bool ASCIIWriter::jsonUniformArray( const T *data, sint64 numElements )
+		{
+			writePrefix();
+			write( "[", 1 );
+			char buffer[maxNumberLength+2] = { ',', ' ' };
+			if( numElements > 0 )
+				sink->write( buffer+2, formatValue( data[0], buffer+2 ) );
+			for( sint64 i=1;i<numElements;++i )
+				sink->write( buffer, 2 + formatValue( data[i], buffer+2 ) );
+			write( "]", 1 );
+			return true;
+		}
+
 
 
 		// JSONLogger ==================================================
@@ -410,7 +690,8 @@ namespace houio
 			void indent()
 			{
 				for( int i=0;i<indentLevel;++i )
-					out << "\t";std::flush(out);
+					out << "\t";
+				std::flush(out);
 			}
 
 			virtual void jsonBeginArray()
@@ -486,20 +767,27 @@ namespace houio
 						uint32 bits;
 						parser->read<uint32>( &bits, 1 );
 						int nbits = std::min( count, 32 );
+						int offset = (int)numElements - count;
 						count -= nbits;
 						for( int i=0;i<nbits;++i )
 						{
 							bool b = (bits & (1 << i)) != 0;
-							data[i] = b;
+							data[offset+i] = b;
 						}
 					}
 				}
 				out << "jsonArray [";std::flush(out);
 				for( std::vector<bool>::iterator it = data.begin(); it != data.end();++it )
-					out << (int)(*it) << " ";std::flush(out);
+					out << (int)(*it) << " ";
+				std::flush(out);
 				out << "]\n";std::flush(out);
 			}
 
+			virtual void uaReal16( sint64 numElements, Parser *parser )
+			{
+				ua<real16>( numElements, parser, "<real16>" );
+			}
+
 			virtual void uaReal32( sint64 numElements, Parser *parser )
 			{
 				ua<real32>( numElements, parser, "<real32>" );
@@ -510,6 +798,19 @@ namespace houio
 				ua<real64>( numElements, parser, "<real64>" );
 			}
 
+			virtual void uaInt8( sint64 numElements, Parser *parser )
+			{
+				indent();
+				std::vector<sbyte> data(numElements);
+				if( numElements != 0 )
+					parser->read<sbyte>( &data[0], numElements );
+				out << "jsonArray<int8> [";std::flush(out);
+				for( std::vector<sbyte>::iterator it = data.begin(); it != data.end();++it )
+					out << (int)(*it) << " ";
+				std::flush(out);
+				out << "]\n";std::flush(out);
+			}
+
 			virtual void uaInt16( sint64 numElements, Parser *parser )
 			{
 				ua<sword>( numElements, parser, "<int16>" );
@@ -533,10 +834,16 @@ namespace houio
 					parser->read<ubyte>( &data[0], numElements );
 				out << "jsonArray<uint8> [";std::flush(out);
 				for( std::vector<ubyte>::iterator it = data.begin(); it != data.end();++it )
-					out << (int)(*it) << " ";std::flush(out);
+					out << (int)(*it) << " ";
+				std::flush(out);
 				out << "]\n";std::flush(out);
 			}
 
+			virtual void uaUInt16( sint64 numElements, Parser *parser )
+			{
+				ua<uword>( numElements, parser, "<uint16>" );
+			}
+
 			virtual void uaString( sint64 numElements, Parser *parser )
 			{
 				indent();
@@ -546,7 +853,8 @@ namespace houio
 					data.push_back( parser->readBinaryString() );
 				out << "jsonArray<string> [";std::flush(out);
 				for( std::vector<std::string>::iterator it = data.begin(); it != data.end();++it )
-					out << *it << " ";std::flush(out);
+					out << *it << " ";
+				std::flush(out);
 				out << "]\n";std::flush(out);
 			}
 
@@ -559,7 +867,8 @@ namespace houio
 					parser->read<T>( (T*)&data[0], numElements );
 				out << "jsonArray"<<type<<" ("<< numElements << ") [";std::flush(out);
 				for( typename std::vector<T>::iterator it = data.begin(); it != data.end();++it )
-					out << *it << " ";std::flush(out);
+					out << *it << " ";
+				std::flush(out);
 				out << "]---\n";std::flush(out);
 			}
 
@@ -585,7 +894,8 @@ namespace houio
 									  real64,         // change
 									  std::string,    // !!!!!! - because index is used in is* methods
 									  ubyte,          // also: if you add something here you need to update Value::cpyTo, JSONWriter::operators
-									  sint64
+									  sint64,
+									  sbyte           // keeps int8 uniform arrays at their width
 									  > Variant;
 
 			Value();
@@ -649,6 +959,11 @@ namespace houio
 		{
 			D &dest;
 			VariantConverter( D &_dest ) : dest(_dest){}
+
+			void operator()(std::string /*x*/)
+			{
+			}
+
 			template< typename T >
 			void operator()( T d )
 			{
@@ -881,20 +1196,27 @@ namespace houio
 			virtual void                 jsonKey( const std::string &key );
 			virtual void                     jsonBool( const bool &value );
 			virtual void                  jsonInt32( const sint32 &value );
+			virtual void                  jsonInt64( const sint64 &value ); // stored as sint32 if it fits
 			virtual void                 jsonReal32( const real32 &value );
 			virtual void      uaBool( sint64 numElements, Parser *parser );
+			virtual void    uaReal16( sint64 numElements, Parser *parser );
 			virtual void    uaReal32( sint64 numElements, Parser *parser );
 			virtual void    uaReal64( sint64 numElements, Parser *parser );
+			virtual void      uaInt8( sint64 numElements, Parser *parser );
 			virtual void     uaInt16( sint64 numElements, Parser *parser );
 			virtual void     uaInt32( sint64 numElements, Parser *parser );
 			virtual void     uaInt64( sint64 numElements, Parser *parser );
 			virtual void     uaUInt8( sint64 numElements, Parser *parser );
+			virtual void    uaUInt16( sint64 numElements, Parser *parser );
 			virtual void    uaString( sint64 numElements, Parser *parser );
 
+			std::set<sint64>                               skippedPayloads; // uniform arrays whose payload starts at one of these stream offsets are read as empty arrays
 
 		private:
 			typedef std::pair<Value, std::string> StackItem; // holds value and nextKey
 
+			bool                skipPayload( sint64 numBytes, Parser *parser ); // seeks over the payload if it is in skippedPayloads
+
 			template<typename T>
 			void                               jsonValue( const T &value );
 			template<typename T, typename S>
@@ -928,6 +1250,8 @@ namespace houio
 		{
 			typedef ttl::meta::find_equivalent_type<const T&, Value::Variant::list> found;
 
+			if( skipPayload( numElements*sizeof(S), parser ) )
+				numElements = 0;
 
 			Value v = Value::createArray();
 			ArrayPtr ua = v.asArray();
@@ -957,12 +1281,12 @@ namespace houio
 		// JSONWriter =========================================
 		struct JSONWriter
 		{
-			JSONWriter( std::ostream *out, bool binary = false )
+			JSONWriter( std::ostream *out, bool binary = false ) : m_binaryWriter(0), m_asciiWriter(0)
 			{
 				if(binary)
-					m_writer = new BinaryWriter(out);
+					m_writer = m_binaryWriter = new BinaryWriter(out);
 				else
-					m_writer = new ASCIIWriter(out);
+					m_writer = m_asciiWriter = new ASCIIWriter(out);
 			}
 
 			~JSONWriter()
@@ -984,9 +1308,22 @@ namespace houio
 			void operator()( real64 value ){m_writer->jsonReal64(value);}
 			void operator()( const std::string &value ){m_writer->jsonString(value);}
 		private:
+			template<typename T>
+			bool       writeUniform( const T *data, sint64 numElements ); // hands uniform arrays to the writer in bulk
+
 			Writer                                  *m_writer;
+			BinaryWriter                      *m_binaryWriter; // one of these equals m_writer
+			ASCIIWriter                        *m_asciiWriter;
 		};
 
+		template<typename T>
+		bool JSONWriter::writeUniform( const T *data, sint64 numElements )
+		{
+			if( m_binaryWriter )
+				return m_binaryWriter->jsonUniformArray<T>( data, numElements );
+			return m_asciiWriter->jsonUniformArray<T>( data, numElements );
+		}
+
 	}
 }
 
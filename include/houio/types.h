@@ -4,6 +4,8 @@
 #include <stdint.h>
 #endif
 
+#include <houio/math/Half/half.h>
+
 namespace houio
 {
 
@@ -43,4 +45,6 @@ typedef int32_t    sdword;
 typedef uint32_t   udword;
 #endif
 
+typedef ::half     real16;
+
 }
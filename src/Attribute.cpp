@@ -9,6 +9,8 @@
 namespace houio
 {
 	Attribute::Attribute( char numComponents, ComponentType componentType ) :
+		m_data(std::make_shared< std::vector<unsigned char> >()),
+		m_offset(0),
 		m_componentType(componentType),
 		m_numComponents(numComponents),
 		m_numElements(0),
@@ -20,13 +22,22 @@ namespace houio
 			{
 				m_componentSize=sizeof(int);
 			}break;
+		case INT8:
+		case UINT8:
+		case INT16:
+		case INT64:
+		case HALF:
+		case DOUBLE:
+			{
+				m_componentSize=componentSize(componentType);
+			}break;
 		default:
 		case FLOAT:
 			{
 				m_componentSize=sizeof(float);
 			}break;
 		};
-
+		m_stride = elementSize();
 	}
 
 	Attribute::~Attribute()
@@ -35,7 +46,137 @@ namespace houio
 
 	Attribute::Ptr Attribute::copy()
 	{
-		return create( numComponents(), elementComponentType(), (unsigned char *)getRawPointer(), numElements() );
+		Attribute::Ptr attr = std::make_shared<Attribute>( numComponents(), elementComponentType() );
+		attr->m_data->resize( numElements()*elementSize() );
+		attr->m_numElements = numElements();
+		gather( attr->m_data->data() );
+		return attr;
+	}
+
+	void Attribute::appendElements( Attribute::Ptr other )
+	{
+		if( (other->numComponents() != numComponents())||(other->elementComponentType() != elementComponentType()) )
+			throw std::runtime_error( "Attribute::appendElements: attribute layout doesnt match" );
+		detach();
+		size_t pos = m_data->size();
+		m_data->resize( pos + other->numElements()*elementSize() );
+		other->gather( m_data->data() + pos );
+		m_numElements += other->numElements();
+		m_isDirty = true;
+	}
+
+	bool Attribute::isShared()const
+	{
+		return m_data.use_count() > 1;
+	}
+
+	bool Attribute::isPacked()const
+	{
+		return (m_offset == 0)&&(m_stride == (size_t)elementSize());
+	}
+
+	void Attribute::detach()
+	{
+		if( !isShared() && isPacked() )
+			return;
+		DataPtr data = std::make_shared< std::vector<unsigned char> >( m_numElements*elementSize() );
+		gather( data->data() );
+		m_data = data;
+		m_offset = 0;
+		m_stride = elementSize();
+	}
+
+	// copies all elements into dst without gaps
+	void Attribute::gather( unsigned char *dst )const
+	{
+		if( m_numElements == 0 )
+			return;
+		if( isPacked() )
+		{
+			memcpy( dst, m_data->data(), m_numElements*elementSize() );
+			return;
+		}
+		const unsigned char *src = m_data->data() + m_offset;
+		size_t size = elementSize();
+		for( size_t i=0;i<m_numElements;++i, src += m_stride, dst += size )
+			memcpy( dst, src, size );
+	}
+
+	Attribute::Ptr Attribute::createView( Attribute::Ptr source, char numComponents, int componentOffset )
+	{
+		if( componentOffset + numComponents > source->numComponents() )
+			throw std::runtime_error( "Attribute::createView: view exceeds components of source" );
+		Attribute::Ptr attr = std::make_shared<Attribute>( numComponents, source->elementComponentType() );
+		attr->m_data = source->m_data;
+		attr->m_offset = source->m_offset + componentOffset*source->elementComponentSize();
+		attr->m_stride = source->m_stride;
+		attr->m_numElements = source->m_numElements;
+		return attr;
+	}
+
+	namespace
+	{
+		template<typename S, typename D>
+		void convertComponents( const S *src, D *dst, size_t numComponents )
+		{
+			for( size_t i=0;i<numComponents;++i )
+				dst[i] = (D)src[i];
+		}
+
+		template<typename S>
+		void convertComponents( const S *src, Attribute::ComponentType dstType, void *dst, size_t numComponents )
+		{
+			switch(dstType)
+			{
+			case Attribute::INT:convertComponents<S, sint32>( src, (sint32*)dst, numComponents );break;
+			case Attribute::FLOAT:convertComponents<S, real32>( src, (real32*)dst, numComponents );break;
+			case Attribute::INT8:convertComponents<S, sbyte>( src, (sbyte*)dst, numComponents );break;
+			case Attribute::UINT8:convertComponents<S, ubyte>( src, (ubyte*)dst, numComponents );break;
+			case Attribute::INT16:convertComponents<S, sint16>( src, (sint16*)dst, numComponents );break;
+			case Attribute::INT64:convertComponents<S, sint64>( src, (sint64*)dst, numComponents );break;
+			case Attribute::HALF:convertComponents<S, real16>( src, (real16*)dst, numComponents );break;
+			case Attribute::DOUBLE:convertComponents<S, real64>( src, (real64*)dst, numComponents );break;
+			default:
+				throw std::runtime_error( "Attribute::convert: unknown component type" );
+			};
+		}
+	}
+
+	// attributes keep the storage they have been loaded with, this is used when a specific type is required
+	Attribute::Ptr Attribute::convert( ComponentType componentType )
+	{
+		Attribute::Ptr attr = std::make_shared<Attribute>( numComponents(), componentType );
+		attr->resize( numElements() );
+
+		size_t numComponentsTotal = numElements()*numComponents();
+		if( numComponentsTotal == 0 )
+			return attr;
+
+		// views are gathered first
+		std::vector<unsigned char> packed;
+		const void *src = data();
+		if( !isPacked() )
+		{
+			packed.resize( numElements()*elementSize() );
+			gather( packed.data() );
+			src = packed.data();
+		}
+
+		void *dst = attr->getRawPointer();
+		switch(elementComponentType())
+		{
+		case INT:convertComponents<sint32>( (const sint32*)src, componentType, dst, numComponentsTotal );break;
+		case FLOAT:convertComponents<real32>( (const real32*)src, componentType, dst, numComponentsTotal );break;
+		case INT8:convertComponents<sbyte>( (const sbyte*)src, componentType, dst, numComponentsTotal );break;
+		case UINT8:convertComponents<ubyte>( (const ubyte*)src, componentType, dst, numComponentsTotal );break;
+		case INT16:convertComponents<sint16>( (const sint16*)src, componentType, dst, numComponentsTotal );break;
+		case INT64:convertComponents<sint64>( (const sint64*)src, componentType, dst, numComponentsTotal );break;
+		case HALF:convertComponents<real16>( (const real16*)src, componentType, dst, numComponentsTotal );break;
+		case DOUBLE:convertComponents<real64>( (const real64*)src, componentType, dst, numComponentsTotal );break;
+		default:
+			throw std::runtime_error( "Attribute::convert: unknown component type" );
+		};
+		return attr;
 	}
 
 	Attribute::ComponentType Attribute::elementComponentType()
@@ -50,8 +191,9 @@ namespace houio
 
 		attr->m_numElements = numElements;
 		int size = attr->elementComponentSize()*attr->numComponents()*attr->numElements();
-		attr->m_data.resize( size );
-		memcpy( &attr->m_data[0], raw, size );
+		attr->m_data->resize( size );
+		if( size > 0 )
+			memcpy( attr->m_data->data(), raw, size );
 
 		return attr;
 	}
@@ -110,7 +252,12 @@ namespace houio
 		{
 		case INT:return sizeof(sint32);
 		case FLOAT:return sizeof(real32);
-		//case REAL64:return sizeof(real64);
+		case INT8:return sizeof(sbyte);
+		case UINT8:return sizeof(ubyte);
+		case INT16:return sizeof(sint16);
+		case INT64:return sizeof(sint64);
+		case HALF:return sizeof(real16);
+		case DOUBLE:return sizeof(real64);
 		default:
 			throw std::runtime_error( "unknown component type" );
 		};
@@ -126,14 +273,35 @@ namespace houio
 		if( ct == "float" )
 			return FLOAT;
 		else
-		//if( ct == "fpreal64" )
-		//	return REAL64;
-		//else
+		if( ct == "fpreal64" )
+			return DOUBLE;
+		else
+		if( ct == "double" )
+			return DOUBLE;
+		else
+		if( ct == "fpreal16" )
+			return HALF;
+		else
+		if( ct == "half" )
+			return HALF;
+		else
 		if( ct == "int32" )
 			return INT;
 		else
 		if( ct == "int" )
 			return INT;
+		else
+		if( ct == "int8" )
+			return INT8;
+		else
+		if( ct == "uint8" )
+			return UINT8;
+		else
+		if( ct == "int16" )
+			return INT16;
+		else
+		if( ct == "int64" )
+			return INT64;
 		return INVALID;
 	}
 
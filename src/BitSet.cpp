@@ -0,0 +1,194 @@
+#include <houio/BitSet.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+
+
+namespace houio
+{
+	BitSet::BitSet( size_t size, bool value ) :
+		m_words( (size+31)/32, value ? 0xffffffff : 0 ),
+		m_size(size)
+	{
+		clearUnusedBits();
+	}
+
+	BitSet::Ptr BitSet::create( size_t size, bool value )
+	{
+		return std::make_shared<BitSet>( size, value );
+	}
+
+	BitSet::Ptr BitSet::copy()const
+	{
+		return std::make_shared<BitSet>( *this );
+	}
+
+	size_t BitSet::size()const
+	{
+		return m_size;
+	}
+
+	void BitSet::resize( size_t size, bool value )
+	{
+		size_t oldSize = m_size;
+		m_words.resize( (size+31)/32, value ? 0xffffffff : 0 );
+		m_size = size;
+		// bits of the last old word beyond the old size have been cleared
+		if( value )
+			for( size_t i=oldSize;i<std::min(size, ((oldSize+31)/32)*32);++i )
+				set( i );
+		clearUnusedBits();
+	}
+
+	bool BitSet::test( size_t index )const
+	{
+		return (m_words[index >> 5] & (1u << (index & 31))) != 0;
+	}
+
+	void BitSet::set( size_t index, bool value )
+	{
+		if( value )
+			m_words[index >> 5] |= (1u << (index & 31));
+		else
+			m_words[index >> 5] &= ~(1u << (index & 31));
+	}
+
+	void BitSet::reset( size_t index )
+	{
+		set( index, false );
+	}
+
+	void BitSet::setAll( bool value )
+	{
+		std::fill( m_words.begin(), m_words.end(), value ? 0xffffffff : 0 );
+		clearUnusedBits();
+	}
+
+	void BitSet::flip()
+	{
+		for( auto &word:m_words )
+			word = ~word;
+		clearUnusedBits();
+	}
+
+	size_t BitSet::count()const
+	{
+		size_t result = 0;
+		for( auto word:m_words )
+			result += popCount( word );
+		return result;
+	}
+
+	bool BitSet::any()const
+	{
+		for( auto word:m_words )
+			if( word )
+				return true;
+		return false;
+	}
+
+	bool BitSet::none()const
+	{
+		return !any();
+	}
+
+	size_t BitSet::findFirst()const
+	{
+		size_t numWords = m_words.size();
+		for( size_t w=0;w<numWords;++w )
+			if( m_words[w] )
+				return w*32 + countTrailingZeros(m_words[w]);
+		return m_size;
+	}
+
+	size_t BitSet::findNext( size_t index )const
+	{
+		++index;
+		if( index >= m_size )
+			return m_size;
+		size_t w = index >> 5;
+		// mask out bits up to index
+		uint32 word = m_words[w] & (0xffffffff << (index & 31));
+		if( word )
+			return w*32 + countTrailingZeros(word);
+		size_t numWords = m_words.size();
+		for( ++w;w<numWords;++w )
+			if( m_words[w] )
+				return w*32 + countTrailingZeros(m_words[w]);
+		return m_size;
+	}
+
+	void BitSet::getIndices( std::vector<int> &indices )const
+	{
+		indices.clear();
+		indices.reserve( count() );
+		forEach( [&]( size_t index ){indices.push_back( (int)index );} );
+	}
+
+	BitSet& BitSet::operator|=( const BitSet &other )
+	{
+		if( other.m_size != m_size )
+			throw std::runtime_error( "BitSet::operator|=: size mismatch" );
+		size_t numWords = m_words.size();
+		for( size_t w=0;w<numWords;++w )
+			m_words[w] |= other.m_words[w];
+		return *this;
+	}
+
+	BitSet& BitSet::operator&=( const BitSet &other )
+	{
+		if( other.m_size != m_size )
+			throw std::runtime_error( "BitSet::operator&=: size mismatch" );
+		size_t numWords = m_words.size();
+		for( size_t w=0;w<numWords;++w )
+			m_words[w] &= other.m_words[w];
+		return *this;
+	}
+
+	BitSet& BitSet::operator^=( const BitSet &other )
+	{
+		if( other.m_size != m_size )
+			throw std::runtime_error( "BitSet::operator^=: size mismatch" );
+		size_t numWords = m_words.size();
+		for( size_t w=0;w<numWords;++w )
+			m_words[w] ^= other.m_words[w];
+		return *this;
+	}
+
+	BitSet& BitSet::subtract( const BitSet &other )
+	{
+		if( other.m_size != m_size )
+			throw std::runtime_error( "BitSet::subtract: size mismatch" );
+		size_t numWords = m_words.size();
+		for( size_t w=0;w<numWords;++w )
+			m_words[w] &= ~other.m_words[w];
+		return *this;
+	}
+
+	size_t BitSet::numWords()const
+	{
+		return m_words.size();
+	}
+
+	uint32* BitSet::getRawPointer()
+	{
+		if( m_words.empty() )
+			return 0;
+		return &m_words[0];
+	}
+
+	const uint32* BitSet::getRawPointer()const
+	{
+		if( m_words.empty() )
+			return 0;
+		return &m_words[0];
+	}
+
+	void BitSet::clearUnusedBits()
+	{
+		if( m_size & 31 )
+			m_words.back() &= (1u << (m_size & 31)) - 1;
+	}
+
+} // namespace houio
@@ -189,7 +189,7 @@ namespace houio
 		else
 			normalAttr->clear();
 
-		Attribute::Ptr positions = getAttr("P");
+		Attribute::CPtr positions = getAttr("P");
 		int numPoints = positions->numElements();
 		for( int i=0; i < numPoints; ++i )
 			normalAttr->appendElement( math::V3f(0.0f, 0.0f, 0.0f) );
@@ -221,7 +221,7 @@ namespace houio
 	{
 		math::BoundingBox3f bound;
 
-		Attribute::Ptr positions = getAttr("P");
+		Attribute::CPtr positions = getAttr("P");
 		if(positions)
 		{
 			int numPoints = positions->numElements();
@@ -646,8 +646,7 @@ namespace houio
 				Attribute::Ptr src = geo->getAttr(attr_name);
 				Attribute::Ptr dst = result->getAttr(attr_name);
 
-				dst->m_data.insert(dst->m_data.end(), src->m_data.begin(), src->m_data.end());
-				dst->m_numElements += src->m_numElements;
+				dst->appendElements( src );
 			}
 			// merge indices
 			for( auto& index : geo->m_indexBuffer )
@@ -878,7 +877,7 @@ namespace houio
 	math::BoundingBox3f compute_bound( Geometry::Ptr geo )
 	{
 		math::BoundingBox3f bbox;
-		Attribute::Ptr p = geo->getAttr( "P" );
+		Attribute::CPtr p = geo->getAttr( "P" );
 		int numElements = p->numElements();
 		for( int i=0;i<numElements;++i )
 			bbox.extend(p->get<math::Vec3f>(i));
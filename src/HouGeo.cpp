@@ -10,7 +10,10 @@ namespace houio
 
 
 	HouGeo::HouGeo() :
-		HouGeoAdapter()
+		HouGeoAdapter(),
+		m_hasVolumeRegion(false),
+		m_volumeRegionIsVoxelSpace(false),
+		m_lazyVolumeLoading(false)
 	{
 	}
 
@@ -117,6 +120,34 @@ namespace houio
 		return m_topology;
 	}
 
+	void HouGeo::getPointGroupNames( std::vector<std::string> &names )const
+	{
+		for( auto it = m_pointGroups.cbegin(); it != m_pointGroups.cend(); ++it )
+			names.push_back( it->first );
+	}
+
+	BitSet::Ptr HouGeo::getPointGroup( const std::string &name )
+	{
+		auto it = m_pointGroups.find(name);
+		if(it != m_pointGroups.end())
+			return it->second;
+		return BitSet::Ptr();
+	}
+
+	void HouGeo::getPrimitiveGroupNames( std::vector<std::string> &names )const
+	{
+		for( auto it = m_primitiveGroups.cbegin(); it != m_primitiveGroups.cend(); ++it )
+			names.push_back( it->first );
+	}
+
+	BitSet::Ptr HouGeo::getPrimitiveGroup( const std::string &name )
+	{
+		auto it = m_primitiveGroups.find(name);
+		if(it != m_primitiveGroups.end())
+			return it->second;
+		return BitSet::Ptr();
+	}
+
 
 	HouGeo::Ptr HouGeo::create()
 	{
@@ -149,6 +180,7 @@ namespace houio
 
 		HouVolume::Ptr hvol = std::make_shared<HouVolume>();
 		hvol->field = field;
+		hvol->getField(); // field is there already, marks the volume as decoded
 
 		std::vector<int> indexList;
 		indexList.push_back( index );
@@ -171,6 +203,46 @@ namespace houio
 	}
 
 
+	// volumes will be cropped to given region during load (only intersecting tiles are decoded)
+	void HouGeo::setVolumeRegion( const math::Box3f &region, bool voxelSpace )
+	{
+		m_hasVolumeRegion = true;
+		m_volumeRegion = region;
+		m_volumeRegionIsVoxelSpace = voxelSpace;
+	}
+
+	// voxel data of volumes will be decoded on first call to HouVolume::getField
+	void HouGeo::setLazyVolumeLoading( bool lazy )
+	{
+		m_lazyVolumeLoading = lazy;
+	}
+
+	// tiles of volume primitives are requested from the loader, the tiles of the json document are ignored
+	// (which allows to parse the document without the tile payloads - see HouGeoIndex)
+	void HouGeo::setTileLoader( const TileLoader &loader )
+	{
+		m_tileLoader = loader;
+	}
+
+	void HouGeo::getVolumes( std::vector<HouVolume::Ptr>& volumes )
+	{
+		volumes.clear();
+		for( auto prim:m_primitives )
+			if( std::dynamic_pointer_cast<HouVolume>(prim) )
+				volumes.push_back( std::dynamic_pointer_cast<HouVolume>(prim) );
+	}
+
+	HouGeo::HouVolume::Ptr HouGeo::getVolume( const std::string &name )
+	{
+		for( auto prim:m_primitives )
+		{
+			HouVolume::Ptr vol = std::dynamic_pointer_cast<HouVolume>(prim);
+			if( vol && (vol->getName() == name) )
+				return vol;
+		}
+		return HouVolume::Ptr();
+	}
+
 	void HouGeo::setPointAttribute( HouAttribute::Ptr attr )
 	{
 		m_pointAttributes[attr->getName()] = attr;
@@ -182,12 +254,35 @@ namespace houio
 		m_primitiveAttributes[name] = attr;
 	}
 
+	void HouGeo::setVertexAttribute( HouAttribute::Ptr attr )
+	{
+		m_vertexAttributes[attr->getName()] = attr;
+	}
+
+	void HouGeo::setGlobalAttribute( HouAttribute::Ptr attr )
+	{
+		m_globalAttributes[attr->getName()] = attr;
+	}
+
+	void HouGeo::setPointGroup( const std::string &name, BitSet::Ptr group )
+	{
+		m_pointGroups[name] = group;
+	}
+
+	void HouGeo::setPrimitiveGroup( const std::string &name, BitSet::Ptr group )
+	{
+		m_primitiveGroups[name] = group;
+	}
+
 	// Attribute ==============================
 
-	HouGeo::HouAttribute::HouAttribute() : AttributeAdapter(), m_type(HouGeoAdapter::AttributeAdapter::ATTR_TYPE_NUMERIC)
+	HouGeo::HouAttribute::HouAttribute() : AttributeAdapter(),
+		m_name("unnamed"),
+		tupleSize(1),
+		m_storage(ATTR_STORAGE_INVALID),
+		m_type(HouGeoAdapter::AttributeAdapter::ATTR_TYPE_NUMERIC),
+		numElements(0)
 	{
-		m_name = "unnamed";
-		numElements = 0;
 	}
 
 	HouGeo::HouAttribute::HouAttribute( const std::string &name, Attribute::Ptr attr ) : AttributeAdapter(),
@@ -202,15 +297,33 @@ namespace houio
 		{
 		case Attribute::FLOAT:
 			m_storage = ATTR_STORAGE_FPREAL32;break;
-		//case ::Attribute::REAL64:
-		//	m_storage = ATTR_STORAGE_FPREAL64;break;
+		case Attribute::DOUBLE:
+			m_storage = ATTR_STORAGE_FPREAL64;break;
+		case Attribute::HALF:
+			m_storage = ATTR_STORAGE_FPREAL16;break;
 		case Attribute::INT:
 			m_storage = ATTR_STORAGE_INT32;break;
+		case Attribute::INT8:
+			m_storage = ATTR_STORAGE_INT8;break;
+		case Attribute::UINT8:
+			m_storage = ATTR_STORAGE_UINT8;break;
+		case Attribute::INT16:
+			m_storage = ATTR_STORAGE_INT16;break;
+		case Attribute::INT64:
+			m_storage = ATTR_STORAGE_INT64;break;
 		default:
 			throw std::runtime_error("HouGeo::HouAttribute::HouAttribute - unsupported attribute type");
 		}
 	}
 
+	// packed data which is shared with other attributes is read in place
+	const void *HouGeo::HouAttribute::getDataPointer()const
+	{
+		if( m_attr && m_attr->isPacked() )
+			return m_attr->data();
+		return 0;
+	}
+
 	std::string HouGeo::HouAttribute::getName()const
 	{
 		return m_name;
@@ -233,10 +346,11 @@ namespace houio
 		return m_storage;
 	}
 
-	void HouGeo::HouAttribute::getPacking( std::vector<int> &packing )const
+	void HouGeo::HouAttribute::getPacking( std::vector<int> & )const
 	{
 	}
 
+	// returns raw pointer to the data (detaches shared data)
 	HouGeoAdapter::RawPointer::Ptr HouGeo::HouAttribute::getRawPointer()
 	{
 		if( m_attr )
@@ -276,7 +390,10 @@ namespace houio
 	{
 		// TODO: check storage
 		// TODO: check type
-		strings.push_back(value);
+		auto it = stringLookup.insert( std::make_pair( value, sint32(strings.size()) ) );
+		if( it.second )
+			strings.push_back(value);
+		stringIndices.push_back( it.first->second );
 		m_type = ATTR_TYPE_STRING;
 		//attr->storage = attrStorage;
 		tupleSize = 1;
@@ -285,7 +402,26 @@ namespace houio
 
 	std::string HouGeo::HouAttribute::getString( int index )const
 	{
-		return strings[index];
+		sint32 stringIndex = stringIndices[index];
+		if( (stringIndex < 0)||(stringIndex >= sint32(strings.size())) )
+			return "";
+		return strings[stringIndex];
+	}
+
+	void HouGeo::HouAttribute::getStringTable( std::vector<std::string> &strings, std::vector<sint32> &indices )const
+	{
+		strings = this->strings;
+		indices = stringIndices;
+	}
+
+	const std::vector<std::string> *HouGeo::HouAttribute::getStrings()const
+	{
+		return &strings;
+	}
+
+	const std::vector<sint32> *HouGeo::HouAttribute::getStringIndices()const
+	{
+		return &stringIndices;
 	}
 
 
@@ -315,6 +451,11 @@ namespace houio
 		return indexBuffer.size();
 	}
 
+	const int *HouGeo::HouTopology::getIndexPointer()const
+	{
+		return indexBuffer.data();
+	}
+
 
 
 
@@ -410,12 +551,212 @@ namespace houio
 			for( int j=0;j<numPrimitives;++j )
 			{
 				json::ArrayPtr primitive = primitives->getArray(j);
-				loadPrimitive( primitive, sharedPrimitiveData );
+				loadPrimitive( primitive, sharedPrimitiveData, j );
+			}
+		}
+		if( o->hasKey("pointgroups") )
+		{
+			json::ArrayPtr groups = o->getArray("pointgroups");
+			sint64 numGroups = groups->size();
+			for( int i=0;i<numGroups;++i )
+			{
+				std::string name;
+				BitSet::Ptr group = loadGroup( groups->getArray(i), numPoints, name );
+				if( group )
+					m_pointGroups[name] = group;
+			}
+		}
+		if( o->hasKey("primitivegroups") )
+		{
+			json::ArrayPtr groups = o->getArray("primitivegroups");
+			sint64 numGroups = groups->size();
+			for( int i=0;i<numGroups;++i )
+			{
+				std::string name;
+				BitSet::Ptr group = loadGroup( groups->getArray(i), numPrimitives, name );
+				if( group )
+					m_primitiveGroups[name] = group;
+			}
+		}
+
+		// volumes are identified by the name primitive attribute
+		HouAttribute::Ptr nameAttr = std::dynamic_pointer_cast<HouAttribute>(getPrimitiveAttribute("name"));
+		if( nameAttr && (nameAttr->getType() == AttributeAdapter::ATTR_TYPE_STRING) )
+		{
+			int primitiveIndex = 0;
+			for( auto prim:m_primitives )
+			{
+				HouVolume::Ptr vol = std::dynamic_pointer_cast<HouVolume>(prim);
+				if( vol && (primitiveIndex < nameAttr->getNumElements()) )
+					vol->name = nameAttr->getString(primitiveIndex);
+				primitiveIndex += prim->numPrimitives();
 			}
 		}
 	}
 
 
+	namespace
+	{
+		// copies a single component from json into attribute memory without going through float or int
+		typedef void (*ComponentCopy)( const json::Value &value, char *dst );
+
+		template<typename T>
+		void copyComponent( const json::Value &value, char *dst )
+		{
+			*((T *)dst) = value.as<T>();
+		}
+
+		ComponentCopy componentCopy( Attribute::ComponentType componentType )
+		{
+			switch( componentType )
+			{
+			case Attribute::INT:return &copyComponent<sint32>;
+			case Attribute::FLOAT:return &copyComponent<real32>;
+			case Attribute::INT8:return &copyComponent<sbyte>;
+			case Attribute::UINT8:return &copyComponent<ubyte>;
+			case Attribute::INT16:return &copyComponent<sint16>;
+			case Attribute::INT64:return &copyComponent<sint64>;
+			case Attribute::HALF:return &copyComponent<real16>;
+			case Attribute::DOUBLE:return &copyComponent<real64>;
+			default:
+				throw std::runtime_error( "HouGeo::loadAttribute: unsupported attribute storage" );
+			};
+			return 0;
+		}
+
+		// decodes the rawpagedata of a values (or indices) block into dense tuples
+		// packs which are flagged in constantpageflags only store a single tuple per page
+		void loadPages( json::ObjectPtr values, sint64 elementCount, int attrTupleSize, char *data, ComponentCopy copy, size_t dstComponentSize )
+		{
+			int dstTupleSize = attrTupleSize;
+			int elementsPerPage = values->get<int>("pagesize");
+
+			// one pack is a sequence of components
+			// packing is used to describe in which sequence components are written to the file
+			// packing allows to store vectors as list of structs or struct of lists.
+			std::vector<ubyte> attrPacking;
+			if( values->hasKey("packing") )
+			{
+				json::ArrayPtr packingArray = values->getArray("packing");
+				int psize = (int)packingArray->size();
+				for( int i=0;i<psize;++i )
+				{
+					attrPacking.push_back( packingArray->get<ubyte>(i) );
+				}
+			}else
+				attrPacking.push_back( attrTupleSize );
+
+			// constantpageflags is an array which
+			// contains an array for each pack
+			// each of those per pack arrays contains flags for each page
+			// which tell us wether the pack is constant for this page
+			std::vector<std::vector<bool>> constantPageFlagsPerPack;
+
+			// to make things even more fun, some packs can be constant
+			// and this may be different per page - oh boy
+			if( values->hasKey("constantpageflags") )
+			{
+				json::ArrayPtr constantPageFlags = values->getArray("constantpageflags");
+
+				// for each pack
+				int i=0;
+				for( auto it = attrPacking.begin(); it != attrPacking.end();++it,++i )
+				{
+					constantPageFlagsPerPack.push_back(std::vector<bool>());
+
+					// get array which tells us for each page if the pack is constant
+					json::ArrayPtr packConstantFlags = constantPageFlags->getArray(i);
+
+					for( int j=0;j<packConstantFlags->size();++j )
+						constantPageFlagsPerPack.back().push_back( packConstantFlags->get<bool>(j) );
+				}
+			}else
+			{
+				for( int j=0;j<attrTupleSize;++j )
+					constantPageFlagsPerPack.push_back(std::vector<bool>());
+			}
+
+			json::ArrayPtr rawPageData = values->getArray("rawpagedata");
+
+			// we need to repack - which when done in a generic way looks like a pain in the butt ======
+
+			int elementsRemaining = int(elementCount);
+			//qDebug() << "numElements " << attr->numElements;
+			//qDebug() << "rawPageData->size() " << (int)rawPageData->size();
+			//qDebug() << "attrTupleSize " << attrTupleSize;
+
+			// process each page
+			int pageIndex = 0;
+			int pageStartIndex = 0;
+			while( elementsRemaining>0 )
+			{
+				int pageStartElement = pageIndex*elementsPerPage;
+				size_t numElements = std::min( elementsRemaining, elementsPerPage );
+
+				// process each pack
+				int packIndex = 0;
+				ubyte startComponentIndex = 0;
+				for( std::vector<ubyte>::iterator it = attrPacking.begin(); it != attrPacking.end();++it, ++packIndex )
+				{
+					ubyte pack = *it;
+					size_t maxPack = std::min( (int)pack, std::max(0, dstTupleSize-startComponentIndex) );
+
+					if( maxPack == 0 )
+						break;
+
+					// is pack for current page constant?
+					bool isConstant = constantPageFlagsPerPack[packIndex].empty() ? false : constantPageFlagsPerPack[packIndex][pageIndex];
+					//qDebug() << "constant? " << isConstant;
+
+
+					// if pack is constant only the first element is given, this is the reference
+					// find element index where the new page starts
+					size_t elementIndex = pageStartIndex;
+
+					// now iterate over all elements of current page and get values from current pack
+					for( size_t i=0;i<numElements;++i )
+					{
+						// we update elementIndex only if pack is varying within current page
+						// otherwise we will just keep pointing to the reference element
+						if( !isConstant )
+							// get page element index into rawpagedata for current pack
+							// we can do pageStartElement*attrTupleSize because packing doesnt matter for past pages
+							elementIndex = pageStartIndex + i*pack;
+							//qDebug() << "elementIndex " << elementIndex;
+							//qDebug() << "pageStartElement " << pageStartElement;
+							//qDebug() << "attrTupleSize " << attrTupleSize;
+							//qDebug() << "i " << i;
+							//qDebug() << "pack " << pack;
+
+						// get global element index for writing into our dense array
+						size_t destElementIndex = (pageStartElement+i)*dstTupleSize;
+
+						// for each component of current pack
+						for( size_t component=0;component<maxPack;++component )
+							// get component value from current rawpagedata
+							// and copy that component to the location of that component in dense array
+							// TODO: uniform arrays!
+							copy( rawPageData->getValue(elementIndex+component), (char *)&(data[(destElementIndex + startComponentIndex + component)*dstComponentSize]) );
+					}
+
+
+					startComponentIndex += pack;
+					if( !isConstant )
+						pageStartIndex += numElements*pack;
+					else
+						pageStartIndex += pack;
+				}
+
+
+				elementsRemaining -= numElements;
+				pageStartElement += numElements;
+
+				// proceed next page
+				++pageIndex;
+			}
+		}
+	}
+
 	HouGeo::HouAttribute::Ptr HouGeo::loadAttribute( json::ArrayPtr attribute, sint64 elementCount )
 	{
 		json::ObjectPtr attrDef = toObject(attribute->getArray(0));
@@ -436,6 +777,7 @@ namespace houio
 			attr->m_attr = std::make_shared<Attribute>( attrNumComponents, attrComponentType );
 			attr->m_attr->resize(elementCount);
 			char *data = (char*)attr->m_attr->getRawPointer();
+			ComponentCopy copy = componentCopy( attrComponentType );
 
 			int attrComponentSize = AttributeAdapter::storageSize( attrStorage );
 			int dstTupleSize = attrTupleSize;
@@ -447,132 +789,8 @@ namespace houio
 				json::ObjectPtr values = toObject( attrData->getArray("values") );
 				if( values->hasKey("rawpagedata") )
 				{
-					int elementsPerPage = values->get<int>("pagesize");
-
-					// one pack is a sequence of components
-					// packing is used to describe in which sequence components are written to the file
-					// packing allows to store vectors as list of structs or struct of lists.
-					std::vector<ubyte> attrPacking;
-					if( values->hasKey("packing") )
-					{
-						json::ArrayPtr packingArray = values->getArray("packing");
-						int psize = (int)packingArray->size();
-						for( int i=0;i<psize;++i )
-						{
-							attrPacking.push_back( packingArray->get<ubyte>(i) );
-						}
-					}else
-						attrPacking.push_back( attrTupleSize );
-
-					// constantpageflags is an array which
-					// contains an array for each pack
-					// each of those per pack arrays contains flags for each page
-					// which tell us wether the pack is constant for this page
-					std::vector<std::vector<bool>> constantPageFlagsPerPack;
-
-					// to make things even more fun, some packs can be constant
-					// and this may be different per page - oh boy
-					if( values->hasKey("constantpageflags") )
-					{
-						json::ArrayPtr constantPageFlags = values->getArray("constantpageflags");
-
-						// for each pack
-						int i=0;
-						for( auto it = attrPacking.begin(); it != attrPacking.end();++it,++i )
-						{
-							constantPageFlagsPerPack.push_back(std::vector<bool>());
-
-							// get array which tells us for each page if the pack is constant
-							json::ArrayPtr packConstantFlags = constantPageFlags->getArray(i);
-
-							for( int j=0;j<packConstantFlags->size();++j )
-								constantPageFlagsPerPack.back().push_back( packConstantFlags->get<bool>(j) );
-						}
-					}else
-					{
-						for( int j=0;j<attrTupleSize;++j )
-							constantPageFlagsPerPack.push_back(std::vector<bool>());
-					}
-
-					json::ArrayPtr rawPageData = values->getArray("rawpagedata");
-
-					// we need to repack - which when done in a generic way looks like a pain in the butt ======
-
+					loadPages( values, elementCount, attrTupleSize, data, copy, dstComponentSize );
 					attr->numElements = elementCount;
-					int elementsRemaining = attr->numElements;
-					//qDebug() << "numElements " << attr->numElements;
-					//qDebug() << "rawPageData->size() " << (int)rawPageData->size();
-					//qDebug() << "attrTupleSize " << attrTupleSize;
-
-					// process each page
-					int pageIndex = 0;
-					int pageStartIndex = 0;
-					while( elementsRemaining>0 )
-					{
-						int pageStartElement = pageIndex*elementsPerPage;
-						size_t numElements = std::min( elementsRemaining, elementsPerPage );
-
-						// process each pack
-						int packIndex = 0;
-						ubyte startComponentIndex = 0;
-						for( std::vector<ubyte>::iterator it = attrPacking.begin(); it != attrPacking.end();++it, ++packIndex )
-						{
-							ubyte pack = *it;
-							size_t maxPack = std::min( (int)pack, std::max(0, dstTupleSize-startComponentIndex) );
-
-							if( maxPack == 0 )
-								break;
-
-							// is pack for current page constant?
-							bool isConstant = constantPageFlagsPerPack[packIndex].empty() ? false : constantPageFlagsPerPack[packIndex][pageIndex];
-							//qDebug() << "constant? " << isConstant;
-
-
-							// if pack is constant only the first element is given, this is the reference
-							// find element index where the new page starts
-							size_t elementIndex = pageStartIndex;
-
-							// now iterate over all elements of current page and get values from current pack
-							for( size_t i=0;i<numElements;++i )
-							{
-								// we update elementIndex only if pack is varying within current page
-								// otherwise we will just keep pointing to the reference element
-								if( !isConstant )
-									// get page element index into rawpagedata for current pack
-									// we can do pageStartElement*attrTupleSize because packing doesnt matter for past pages
-									elementIndex = pageStartIndex + i*pack;
-									//qDebug() << "elementIndex " << elementIndex;
-									//qDebug() << "pageStartElement " << pageStartElement;
-									//qDebug() << "attrTupleSize " << attrTupleSize;
-									//qDebug() << "i " << i;
-									//qDebug() << "pack " << pack;
-
-								// get global element index for writing into our dense array
-								size_t destElementIndex = (pageStartElement+i)*dstTupleSize;
-
-								// for each component of current pack
-								for( size_t component=0;component<maxPack;++component )
-									// get component value from current rawpagedata
-									// and copy that component to the location of that component in dense array
-									// TODO: uniform arrays!
-									rawPageData->getValue(elementIndex+component).cpyTo( (char *)&(data[(destElementIndex + startComponentIndex + component)*dstComponentSize]) );
-							}
-
-
-							startComponentIndex += pack;
-							if( !isConstant )
-								pageStartIndex += numElements*pack;
-							else
-								pageStartIndex += pack;
-						}
-
-
-						elementsRemaining -= numElements;
-						pageStartElement += numElements;
-
-						// proceed next page
-						++pageIndex;
-					}
 
 					attr->m_name = attrName;
 					attr->m_type = attrType;
@@ -586,14 +804,32 @@ namespace houio
 			if( attrData->hasKey("strings") )
 			{
 				json::ArrayPtr stringsArray = attrData->getArray("strings");
-				int numElements = stringsArray->size();
-				for( int i=0;i<numElements;++i )
+				int numStrings = stringsArray->size();
+				for( int i=0;i<numStrings;++i )
 				{
 					std::string string = stringsArray->get<std::string>( i );
 					attr->strings.push_back(string);
+					attr->stringLookup.insert( std::make_pair( string, sint32(i) ) );
 					//qDebug() << QString::fromStdString(string);
 				}
-				attr->numElements = numElements;
+
+				// per element indices into the string table
+				json::ObjectPtr indices;
+				if( attrData->hasKey("indices") )
+					indices = toObject( attrData->getArray("indices") );
+				if( indices && indices->hasKey("rawpagedata") )
+				{
+					attr->stringIndices.resize( elementCount );
+					loadPages( indices, elementCount, 1, (char*)attr->stringIndices.data(), &copyComponent<sint32>, sizeof(sint32) );
+					attr->numElements = int(elementCount);
+				}else
+				{
+					// no indices, one string per element
+					attr->stringIndices.resize( numStrings );
+					for( int i=0;i<numStrings;++i )
+						attr->stringIndices[i] = i;
+					attr->numElements = numStrings;
+				}
 
 				attr->m_name = attrName;
 				attr->m_type = attrType;
@@ -623,7 +859,66 @@ namespace houio
 		m_topology = top;
 	}
 
-	void HouGeo::loadPrimitive( json::ArrayPtr primitive, SharedPrimitiveData& sharedPrimitiveData )
+	// groups have 2 arrays: the definition (name) and the selection
+	// the selection holds a bool per element, either as bitstream (i8) or run length encoded (boolRLE)
+	BitSet::Ptr HouGeo::loadGroup( json::ArrayPtr group, sint64 elementCount, std::string &name )
+	{
+		json::ObjectPtr groupDef = toObject(group->getArray(0));
+		json::ObjectPtr groupData = toObject(group->getArray(1));
+		name = groupDef->get<std::string>("name");
+
+		BitSet::Ptr bits = BitSet::create( elementCount );
+		if( !groupData->hasKey("selection") )
+			return bits;
+		json::ObjectPtr selection = toObject( groupData->getArray("selection") );
+		if( !selection->hasKey("unordered") )
+		{
+			std::cout << "HouGeo::loadGroup: warning: unsupported selection for group " << name << std::endl;
+			return bits;
+		}
+		json::ObjectPtr unordered = toObject( selection->getArray("unordered") );
+		if( unordered->hasKey("i8") )
+		{
+			json::ArrayPtr flags = unordered->getArray("i8");
+			sint64 numFlags = std::min( flags->size(), elementCount );
+			typedef ttl::meta::find_equivalent_type<const bool&, json::Value::Variant::list> boolType;
+			if( flags->isUniform() && (flags->m_uniformType == boolType::index) )
+			{
+				if( numFlags > 0 )
+				{
+					// bitstream from binary file has the same layout as our bitset
+					memcpy( bits->getRawPointer(), flags->m_uniformdata, ((numFlags+31)/32)*sizeof(uint32) );
+					bits->clearUnusedBits();
+				}
+			}else
+			{
+				for( int i=0;i<numFlags;++i )
+					if( flags->get<bool>(i) )
+						bits->set(i);
+			}
+		}else
+		if( unordered->hasKey("boolRLE") )
+		{
+			// pairs of run length and value
+			json::ArrayPtr runs = unordered->getArray("boolRLE");
+			sint64 numRuns = runs->size()/2;
+			sint64 index = 0;
+			for( int i=0;i<numRuns;++i )
+			{
+				sint64 runLength = runs->get<int>(i*2);
+				bool value = runs->get<bool>(i*2+1);
+				sint64 runEnd = std::min( index+runLength, elementCount );
+				if( value )
+					for( sint64 j=index;j<runEnd;++j )
+						bits->set(j);
+				index = runEnd;
+			}
+		}
+		return bits;
+	}
+
+	// primitiveIndex is the index of the primitive within the primitives array of the file
+	void HouGeo::loadPrimitive( json::ArrayPtr primitive, SharedPrimitiveData& sharedPrimitiveData, sint64 primitiveIndex )
 	{
 		// we follow the scheme from houdini...
 
@@ -637,7 +932,7 @@ namespace houio
 
 		// primitive
 		if( primitiveType=="Volume" )
-			loadVolumePrimitive( toObject(primitive->getArray(1)), sharedPrimitiveData );
+			loadVolumePrimitive( toObject(primitive->getArray(1)), sharedPrimitiveData, primitiveIndex );
 		else
 		if( primitiveType=="Poly" )
 			loadPolyPrimitive( toObject(primitive->getArray(1)) );
@@ -646,21 +941,25 @@ namespace houio
 		{
 			if( primdef->get<std::string>( "runtype" ) == "Poly" )
 				loadPolyPrimitiveRun( primdef, primitive->getArray(1) );
-		}
+		}else
+		if( primitiveType=="Polygon_run" )
+			loadPolygonRun( toObject(primitive->getArray(1)) );
 
 	}
 
 	// HouGeo::HouVolume ==================================================
 
-	void HouGeo::loadVolumePrimitive( json::ObjectPtr volume, SharedPrimitiveData& sharedPrimitiveData )
+	void HouGeo::loadVolumePrimitive( json::ObjectPtr volume, SharedPrimitiveData& sharedPrimitiveData, sint64 primitiveIndex )
 	{
 		HouVolume::Ptr vol = std::make_shared<HouVolume>();
-		vol->field = std::make_shared<ScalarField>();
+
+		math::V3i res(1);
+		math::M44f localToWorld = math::M44f::Identity();
 
 		if( volume->hasKey("res") )
 		{
-			json::ArrayPtr res = volume->getArray("res");
-			vol->field->resize(res->get<int>(0), res->get<int>(1), res->get<int>(2));
+			json::ArrayPtr resArray = volume->getArray("res");
+			res = math::V3i(resArray->get<int>(0), resArray->get<int>(1), resArray->get<int>(2));
 		}
 		if( volume->hasKey("vertex") && volume->hasKey("transform") )
 		{
@@ -688,13 +987,18 @@ namespace houio
 				// in case of 4 component vector, w component will be ignored...
 				case AttributeAdapter::ATTR_STORAGE_FPREAL32:
 					{
-						//p = *(math::V3f *)&m_pointAttributes.find("P")->second->data[ v*pAttr->tupleSize*sizeof(float) ];
-						p = m_pointAttributes.find("P")->second->m_attr->get<math::V3f>( v );
+						real32 *ptr = (real32 *)pAttr->m_attr->getRawPointer( v );
+						p = math::V3f( ptr[0], ptr[1], ptr[2] );
 					}break;
 				case AttributeAdapter::ATTR_STORAGE_FPREAL64:
 					{
-						//p = *(math::V3d *)&m_pointAttributes.find("P")->second->data[ v*pAttr->tupleSize*sizeof(double) ];
-						p = m_pointAttributes.find("P")->second->m_attr->get<math::V3d>( v );
+						real64 *ptr = (real64 *)pAttr->m_attr->getRawPointer( v );
+						p = math::V3f( (float)ptr[0], (float)ptr[1], (float)ptr[2] );
+					}break;
+				case AttributeAdapter::ATTR_STORAGE_FPREAL16:
+					{
+						real16 *ptr = (real16 *)pAttr->m_attr->getRawPointer( v );
+						p = math::V3f( ptr[0], ptr[1], ptr[2] );
 					}break;
 				case AttributeAdapter::ATTR_STORAGE_INVALID:
 				case AttributeAdapter::ATTR_STORAGE_INT32:
@@ -704,40 +1008,134 @@ namespace houio
 			}
 			math::Matrix44d houLocalToWorldTranslation = math::Matrix44d::TranslationMatrix(p);
 
-			math::Matrix44d localToWorld = math::Matrix44d::ScaleMatrix(2.0)*math::Matrix44d::TranslationMatrix(-1.0,-1.0,-1.0)*houLocalToWorldRotationScale*houLocalToWorldTranslation;
+			localToWorld = math::Matrix44d::ScaleMatrix(2.0)*math::Matrix44d::TranslationMatrix(-1.0,-1.0,-1.0)*houLocalToWorldRotationScale*houLocalToWorldTranslation;
+		}
+
+		// work out which voxels we are going to load
+		math::V3i voxelMin(0);
+		math::V3i voxelMax = res;
+		if( m_hasVolumeRegion )
+		{
+			math::Box3f vsRegion = m_volumeRegion;
+			if( !m_volumeRegionIsVoxelSpace )
+			{
+				// transform the corners of the worldspace region into voxelspace
+				math::M44f worldToVoxel = localToWorld.inverted()*math::M44f::ScaleMatrix( float(res.x), float(res.y), float(res.z) );
+				vsRegion.makeEmpty();
+				for( int c=0;c<8;++c )
+				{
+					math::V3f wsP( (c&1) ? m_volumeRegion.maxPoint.x : m_volumeRegion.minPoint.x,
+								   (c&2) ? m_volumeRegion.maxPoint.y : m_volumeRegion.minPoint.y,
+								   (c&4) ? m_volumeRegion.maxPoint.z : m_volumeRegion.minPoint.z );
+					vsRegion.extendBy( wsP*worldToVoxel );
+				}
+			}
+			for( int i=0;i<3;++i )
+			{
+				voxelMin[i] = std::max( 0, std::min( res[i], (int)std::floor(vsRegion.minPoint[i]) ) );
+				voxelMax[i] = std::max( voxelMin[i], std::min( res[i], (int)std::ceil(vsRegion.maxPoint[i]) ) );
+			}
+
+			// the cropped field covers a subset of the localspace of the original volume
+			math::V3f lsMin( float(voxelMin.x)/float(res.x), float(voxelMin.y)/float(res.y), float(voxelMin.z)/float(res.z) );
+			math::V3f lsSize( float(voxelMax.x-voxelMin.x)/float(res.x), float(voxelMax.y-voxelMin.y)/float(res.y), float(voxelMax.z-voxelMin.z)/float(res.z) );
+			localToWorld = math::M44f::ScaleMatrix(lsSize)*math::M44f::TranslationMatrix(lsMin)*localToWorld;
+		}
+		math::V3i croppedRes = voxelMax - voxelMin;
+		bool isCropped = (croppedRes.x != res.x)||(croppedRes.y != res.y)||(croppedRes.z != res.z);
+
+		vol->resolution = croppedRes;
+		vol->localToWorld = localToWorld;
 
-			vol->field->setLocalToWorld( localToWorld );
+		// region doesnt intersect the volume - there is nothing to decode
+		if( (croppedRes.x <= 0)||(croppedRes.y <= 0)||(croppedRes.z <= 0) )
+		{
+			m_primitives.push_back( vol );
+			return;
 		}
 
+		// find the voxel data ---
+		json::ObjectPtr voxels;
+		std::string decodedid;
 		if( volume->hasKey("sharedvoxels") )
 		{
 			std::string dataid = volume->get<std::string>("sharedvoxels");
 			auto it = sharedPrimitiveData.sharedVoxelData.find(dataid);
-			if( it != sharedPrimitiveData.sharedVoxelData.end() )
-			{
-				json::ObjectPtr voxels = it->second;
-				loadVoxelData( voxels, vol->field->getResolution(), vol->field->getRawPointer() );
-			}else
+			if( it == sharedPrimitiveData.sharedVoxelData.end() )
 				throw std::runtime_error( "HouGeo::loadVolumePrimitive: error shared voxel data not found\n" );
+			voxels = it->second;
+			// cropped blocks depend on the region of each individual volume
+			decodedid = dataid;
+			if( isCropped )
+				decodedid += "@" + json::toString(voxelMin.x) + "," + json::toString(voxelMin.y) + "," + json::toString(voxelMin.z) + "-" + json::toString(voxelMax.x) + "," + json::toString(voxelMax.y) + "," + json::toString(voxelMax.z);
 		}
-
+		std::function<json::ArrayPtr( sint64 tile )> tileLoader;
 		if( volume->hasKey("voxels") )
 		{
-			loadVoxelData( toObject(volume->getArray("voxels")), vol->field->getResolution(), vol->field->getRawPointer() );
+			voxels = toObject(volume->getArray("voxels"));
+			decodedid = "";
+			// shared voxel data is not owned by a primitive and always comes from the document
+			if( m_tileLoader )
+			{
+				TileLoader loader = m_tileLoader;
+				tileLoader = [=]( sint64 tile ){ return loader( primitiveIndex, tile ); };
+			}
 		}
 
+		// decoding is deferred until the field is requested when loading lazily
+		std::shared_ptr<DecodedVoxelData> decodedVoxelData = sharedPrimitiveData.decodedVoxelData;
+		vol->decode = [=]( ScalarField& field )
+		{
+			if( !decodedid.empty() )
+			{
+				// voxel block has been decoded for another volume already - we share its buffer
+				// the field will copy the data once it is being written to
+				std::lock_guard<std::mutex> lock( decodedVoxelData->mutex );
+				ScalarField::DataPtr decoded = decodedVoxelData->blocks[decodedid].lock();
+				if( decoded )
+				{
+					field.setData( decoded );
+					return;
+				}
+			}
+			if( voxels )
+				loadVoxelData( voxels, res, field.getRawPointer(), voxelMin, voxelMax, tileLoader );
+			if( !decodedid.empty() )
+			{
+				// another thread may have decoded the same block in the meantime, both buffers are valid
+				std::lock_guard<std::mutex> lock( decodedVoxelData->mutex );
+				decodedVoxelData->blocks[decodedid] = field.getData();
+			}
+		};
+
+		if( !m_lazyVolumeLoading )
+			vol->getField();
+
 		m_primitives.push_back( vol );
 	}
 
 	void HouGeo::loadVoxelData( json::ObjectPtr voxels, const math::V3i& res, float* volData )
 	{
+		loadVoxelData( voxels, res, volData, math::V3i(0), res );
+	}
+
+	// volData holds the voxels within [voxelMin, voxelMax) only, tiles outside that region are not decoded
+	// tiles are taken from tileLoader if given (tiles of voxels are still required for their number)
+	void HouGeo::loadVoxelData( json::ObjectPtr voxels, const math::V3i& res, float* volData, const math::V3i& voxelMin, const math::V3i& voxelMax, const std::function<json::ArrayPtr( sint64 tile )> &tileLoader )
+	{
+		math::V3i dstRes = voxelMax - voxelMin;
+		if( (dstRes.x <= 0)||(dstRes.y <= 0)||(dstRes.z <= 0) )
+			return;
+
 		if( voxels->hasKey("tiledarray") )
 		{
 			json::ObjectPtr tiledarray = toObject(voxels->getArray("tiledarray"));
 
 			std::vector<int> compressionTypes;
+			// 0 = raw
 			// 1 = rawfull
 			// 2 = constant
+			// 3 = fpreal16
 
 			if( tiledarray->hasKey("compressiontypes") )
 			{
@@ -753,6 +1151,9 @@ namespace houio
 					else
 					if( ct->get<std::string>(cti) == "constant" )
 						compressionTypes.push_back( 2 );
+					else
+					if( ct->get<std::string>(cti) == "fpreal16" )
+						compressionTypes.push_back( 3 );
 					else
 						compressionTypes.push_back( -1 );
 				}
@@ -787,35 +1188,43 @@ namespace houio
 				if( (tileEnd.x*tileEnd.y*tileEnd.z)!=numTiles )
 					throw std::runtime_error("HouGeo::loadVolumePrimitive problem");
 
-				int currentTileIndex = 0;
 				math::Vec3i voxelOffset; // start offset (in voxels) for current tile
 				math::Vec3i numVoxels;   // number of voxels for current tile (may differ in each dimension)
+				math::Vec3i copyStart;   // range of voxels (relative to current tile) which lie within the requested region
+				math::Vec3i copyEnd;
 
 				// we iterate all tiles starting from slowest to fastest (inner loop)
-				// in each iteration we compute the amount of remaining voxels which is either 16 or smaller for boundary tiles
-				int remainK = res.z;
-				for( int tk=0; tk<tileEnd.z;++tk )
+				// only tiles which overlap the requested region are touched
+				for( int tk=voxelMin.z/16; tk*16<voxelMax.z;++tk )
 				{
 					voxelOffset.z = tk*16;
-					numVoxels.z = std::min( 16,  remainK );
+					numVoxels.z = std::min( 16,  res.z - voxelOffset.z );
+					copyStart.z = std::max( 0, voxelMin.z - voxelOffset.z );
+					copyEnd.z = std::min( numVoxels.z, voxelMax.z - voxelOffset.z );
 
-					int remainJ = res.y;
-					for( int tj=0; tj<tileEnd.y;++tj )
+					for( int tj=voxelMin.y/16; tj*16<voxelMax.y;++tj )
 					{
 						voxelOffset.y = tj*16;
-						numVoxels.y = std::min( 16,  remainJ );
+						numVoxels.y = std::min( 16,  res.y - voxelOffset.y );
+						copyStart.y = std::max( 0, voxelMin.y - voxelOffset.y );
+						copyEnd.y = std::min( numVoxels.y, voxelMax.y - voxelOffset.y );
 
-						int remainI = res.x;
-						for( int ti=0; ti<tileEnd.x;++ti, ++currentTileIndex )
+						for( int ti=voxelMin.x/16; ti*16<voxelMax.x;++ti )
 						{
 							voxelOffset.x = ti*16;
-							numVoxels.x = std::min( 16,  remainI );
+							numVoxels.x = std::min( 16,  res.x - voxelOffset.x );
+							copyStart.x = std::max( 0, voxelMin.x - voxelOffset.x );
+							copyEnd.x = std::min( numVoxels.x, voxelMax.x - voxelOffset.x );
 
-							json::ObjectPtr tile = toObject(tiles->getArray(currentTileIndex));
+							int currentTileIndex = (tk*tileEnd.y + tj)*tileEnd.x + ti;
+							json::ObjectPtr tile = toObject( tileLoader ? tileLoader(currentTileIndex) : tiles->getArray(currentTileIndex) );
 							int tileCompression = 1;
 							if( tile->hasKey("compression") )
 							{
 								tileCompression = tile->get<sint32>("compression");
+								// tiles refer to the compressiontypes list of the file if there is one
+								if( !compressionTypes.empty() )
+									tileCompression = ((tileCompression >= 0)&&(tileCompression < int(compressionTypes.size()))) ? compressionTypes[tileCompression] : -1;
 							}
 							if( tile->hasKey("data") )
 							{
@@ -823,6 +1232,7 @@ namespace houio
 								{
 								case 0: // raw
 								case 1: // rawfull
+								case 3: // fpreal16 (widened to float by the reader)
 									{
 										json::ArrayPtr data = tile->getArray("data");
 										int numElements = (int)data->size();
@@ -832,28 +1242,28 @@ namespace houio
 
 										if( data->isUniform() && (data->m_uniformType == 2) )
 										{
-											int v = 0;
-											for( int k=0;k<numVoxels.z;++k )
-												for( int j=0;j<numVoxels.y;++j, v+=numVoxels.x )
+											for( int k=copyStart.z;k<copyEnd.z;++k )
+												for( int j=copyStart.y;j<copyEnd.y;++j )
+												{
+													int v = (k*numVoxels.y + j)*numVoxels.x + copyStart.x;
 													// copy a complete scanline directly
-													memcpy( &volData[(tk*16+k)*res.x*res.y + (tj*16+j)*res.x + (ti*16)], &data->m_uniformdata[v*sizeof(float)], numVoxels.x*sizeof(float) );
+													memcpy( &volData[(voxelOffset.z+k-voxelMin.z)*dstRes.x*dstRes.y + (voxelOffset.y+j-voxelMin.y)*dstRes.x + (voxelOffset.x+copyStart.x-voxelMin.x)], &data->m_uniformdata[v*sizeof(float)], (copyEnd.x-copyStart.x)*sizeof(float) );
+												}
 										}else
 										{
-											int v = 0;
-											for( int k=0;k<numVoxels.z;++k )
-												for( int j=0;j<numVoxels.y;++j )
-													for( int i=0;i<numVoxels.x;++i,++v )
-														volData[(tk*16+k)*res.x*res.y + (tj*16+j)*res.x + (ti*16+i)] = data->get<float>(v);
+											for( int k=copyStart.z;k<copyEnd.z;++k )
+												for( int j=copyStart.y;j<copyEnd.y;++j )
+													for( int i=copyStart.x;i<copyEnd.x;++i )
+														volData[(voxelOffset.z+k-voxelMin.z)*dstRes.x*dstRes.y + (voxelOffset.y+j-voxelMin.y)*dstRes.x + (voxelOffset.x+i-voxelMin.x)] = data->get<float>((k*numVoxels.y + j)*numVoxels.x + i);
 										}
 									}break;
 								case 2: // constant
 									{
 										float data = tile->get<float>("data");
-										int v = 0;
-										for( int k=0;k<numVoxels.z;++k )
-											for( int j=0;j<numVoxels.y;++j )
-												for( int i=0;i<numVoxels.x;++i,++v )
-													volData[(tk*16+k)*res.x*res.y + (tj*16+j)*res.x + (ti*16+i)] = data;
+										for( int k=copyStart.z;k<copyEnd.z;++k )
+											for( int j=copyStart.y;j<copyEnd.y;++j )
+												for( int i=copyStart.x;i<copyEnd.x;++i )
+													volData[(voxelOffset.z+k-voxelMin.z)*dstRes.x*dstRes.y + (voxelOffset.y+j-voxelMin.y)*dstRes.x + (voxelOffset.x+i-voxelMin.x)] = data;
 
 									}break;
 								case -1:
@@ -862,21 +1272,25 @@ namespace houio
 									break;
 								};
 							}
-							remainI -=16;
 						}
-						remainJ -=16;
 					}
-					remainK -=16;
 				}
 			}
 		}else // /tiledarray
 		if( voxels->hasKey("constantarray") )
 		{
 			float constantValue = voxels->get<float>( "constantarray" );
-			std::fill( volData, volData + res.x*res.y*res.z, constantValue );
+			std::fill( volData, volData + dstRes.x*dstRes.y*dstRes.z, constantValue );
 		}
 	}
 
+	HouGeo::HouVolume::HouVolume() :
+		VolumePrimitive(),
+		vertex(0),
+		m_decoded(false)
+	{
+	}
+
 	int HouGeo::HouVolume::getVertex()const
 	{
 		return vertex;
@@ -884,27 +1298,92 @@ namespace houio
 
 	real32 HouGeo::HouVolume::getVoxel( int i, int j, int k )const
 	{
-		return field->sample(i, j, k);
+		return getField()->sample(i, j, k);
 	}
 	
+	// field is assigned by the decoding thread, it is only read once decoding has finished
 	math::Vec3i HouGeo::HouVolume::getResolution()const
 	{
-		return field->getResolution();
+		if( m_decoded.load() && field )
+			return field->getResolution();
+		return resolution;
 	}
 
 	math::M44f HouGeo::HouVolume::getTransform()const
 	{
-		return field->m_localToWorld;
+		if( m_decoded.load() && field )
+			return field->m_localToWorld;
+		return localToWorld;
 	}
 
-	// returns raw pointer to the data
+	// returns raw pointer to the data (detaches shared voxel data)
 	HouGeoAdapter::RawPointer::Ptr HouGeo::HouVolume::getRawPointer()
 	{
-		return HouGeoAdapter::RawPointer::create(field->getRawPointer());
+		ScalarField::Ptr f = getField();
+		return HouGeoAdapter::RawPointer::create( f ? f->getRawPointer() : 0 );
+	}
+
+	// voxels for reading, shared voxel data is not detached
+	const real32 *HouGeo::HouVolume::getVoxelPointer()const
+	{
+		ScalarField::CPtr f = getField();
+		return f ? f->getRawPointer() : 0;
+	}
+
+	std::string HouGeo::HouVolume::getName()const
+	{
+		return name;
+	}
+
+	// decodes voxel data on first access if volume has been loaded lazily
+	ScalarField::Ptr HouGeo::HouVolume::getField()
+	{
+		decodeOnce();
+		return field;
+	}
+
+	ScalarField::CPtr HouGeo::HouVolume::getField()const
+	{
+		decodeOnce();
+		return field;
+	}
+
+	bool HouGeo::HouVolume::isDecoded()const
+	{
+		return m_decoded;
+	}
+
+	// the json data captured by the decoder is released as soon as the voxels have been decoded
+	void HouGeo::HouVolume::decodeOnce()const
+	{
+		if( m_decoded )
+			return;
+		std::call_once( m_decodeFlag, [this]
+		{
+			if( !field )
+			{
+				ScalarField::Ptr f = std::make_shared<ScalarField>();
+				f->resize( resolution );
+				f->setLocalToWorld( localToWorld );
+				if( decode )
+					decode( *f );
+				field = f;
+			}
+			decode = nullptr;
+			m_decoded = true;
+		});
 	}
 
 
 	// HouGeo::HouPoly ==================================================
+	HouGeo::HouPoly::HouPoly() :
+		PolyPrimitive(),
+		m_numPolys(0),
+		m_closed(true),
+		m_startVertex(-1)
+	{
+	}
+
 	void HouGeo::loadPolyPrimitive( json::ObjectPtr poly )
 	{
 		HouPoly::Ptr pol = std::make_shared<HouPoly>();
@@ -920,18 +1399,25 @@ namespace houio
 			pol->m_numPolys = 1;
 			pol->m_perPolyVertexCount.push_back(numVertices);
 			pol->m_perPolyVertexListOffset.push_back(0);
+			pol->m_startVertex = numVertices > 0 ? vertex->get<sint32>(0) : -1;
 			for(int i=0;i<numVertices;++i)
-				pol->m_vertices.push_back( m_topology->indexBuffer[vertex->get<sint32>(i)] );
+			{
+				sint32 v = vertex->get<sint32>(i);
+				if( v != pol->m_startVertex + i )
+					pol->m_startVertex = -1;
+				pol->m_vertices.push_back( m_topology->indexBuffer[v] );
+			}
 		}
 
 		m_primitives.push_back( pol );
 	}
 
-	void HouGeo::loadPolyPrimitiveRun( json::ObjectPtr def, json::ArrayPtr run )
+	void HouGeo::loadPolyPrimitiveRun( json::ObjectPtr, json::ArrayPtr run )
 	{
 		HouPoly::Ptr pol = std::make_shared<HouPoly>();
 		pol->m_numPolys = (int) run->size();
 		int vertex = 0;
+		bool sequential = true; // vertex numbers continue from the first one
 		for( int i=0;i<pol->m_numPolys;++i )
 		{
 			json::ArrayPtr c = run->getArray(i)->getArray(0);
@@ -939,8 +1425,58 @@ namespace houio
 			pol->m_perPolyVertexCount.push_back(numVertices);
 			pol->m_perPolyVertexListOffset.push_back(vertex);
 			for( int j=0;j<numVertices; ++j, ++vertex )
-				pol->m_vertices.push_back(m_topology->indexBuffer[c->get<sint32>(j)]);
+			{
+				sint32 v = c->get<sint32>(j);
+				if( vertex == 0 )
+					pol->m_startVertex = v;
+				else
+				if( v != pol->m_startVertex + vertex )
+					sequential = false;
+				pol->m_vertices.push_back(m_topology->indexBuffer[v]);
+			}
 		}
+		if( !sequential )
+			pol->m_startVertex = -1;
+		m_primitives.push_back( pol );
+	}
+
+	// closed polygons whose vertices are numbered sequentially from startvertex on
+	// the vertex counts are either run length encoded (pairs of vertex count and number of polygons) or given per polygon
+	void HouGeo::loadPolygonRun( json::ObjectPtr run )
+	{
+		if( !m_topology )
+			throw std::runtime_error( "HouGeo::loadPolygonRun expects topology to be loaded already!" );
+
+		HouPoly::Ptr pol = std::make_shared<HouPoly>();
+		pol->m_numPolys = run->get<int>( "nprimitives" );
+		if( run->hasKey("nvertices_rle") )
+		{
+			json::ArrayPtr rle = run->getArray("nvertices_rle");
+			for( int i=0;i+1<(int)rle->size();i+=2 )
+				pol->m_perPolyVertexCount.insert( pol->m_perPolyVertexCount.end(), rle->get<int>(i+1), rle->get<int>(i) );
+		}else
+		if( run->hasKey("nvertices") )
+		{
+			json::ArrayPtr counts = run->getArray("nvertices");
+			for( int i=0;i<(int)counts->size();++i )
+				pol->m_perPolyVertexCount.push_back( counts->get<int>(i) );
+		}
+		if( (int)pol->m_perPolyVertexCount.size() != pol->m_numPolys )
+			throw std::runtime_error( "HouGeo::loadPolygonRun: vertex counts dont match nprimitives" );
+
+		sint64 vertex = run->get<int>( "startvertex" );
+		pol->m_perPolyVertexListOffset.resize( pol->m_numPolys );
+		int offset = 0;
+		for( int i=0;i<pol->m_numPolys;++i )
+		{
+			pol->m_perPolyVertexListOffset[i] = offset;
+			offset += pol->m_perPolyVertexCount[i];
+		}
+		if( (vertex < 0)||(vertex + offset > sint64(m_topology->indexBuffer.size())) )
+			throw std::runtime_error( "HouGeo::loadPolygonRun: vertices exceed topology" );
+		pol->m_vertices.assign( m_topology->indexBuffer.begin() + vertex, m_topology->indexBuffer.begin() + vertex + offset );
+		pol->m_closed = true;
+		pol->m_startVertex = int(vertex);
 		m_primitives.push_back( pol );
 	}
 
@@ -964,6 +1500,11 @@ namespace houio
 		return m_closed;
 	}
 
+	int HouGeo::HouPoly::startVertex()const
+	{
+		return m_startVertex;
+	}
+
 
 
 	// MISC =======================================================
@@ -2,6 +2,7 @@
 #include <houio/HouGeo.h>
 
 #include <fstream>
+#include <unordered_map>
 
 
 namespace houio
@@ -62,6 +63,36 @@ namespace houio
 		return HouGeoAdapter::RawPointer::Ptr();
 	}
 
+	const void *HouGeoAdapter::AttributeAdapter::getDataPointer()const
+	{
+		return 0;
+	}
+
+	void HouGeoAdapter::AttributeAdapter::getStringTable( std::vector<std::string> &strings, std::vector<sint32> &indices )const
+	{
+		int numElements = getNumElements();
+		std::unordered_map<std::string, sint32> lookup;
+		strings.clear();
+		indices.resize( numElements );
+		for( int i=0;i<numElements;++i )
+		{
+			auto it = lookup.insert( std::make_pair( getString(i), sint32(strings.size()) ) );
+			if( it.second )
+				strings.push_back( it.first->first );
+			indices[i] = it.first->second;
+		}
+	}
+
+	const std::vector<std::string> *HouGeoAdapter::AttributeAdapter::getStrings()const
+	{
+		return 0;
+	}
+
+	const std::vector<sint32> *HouGeoAdapter::AttributeAdapter::getStringIndices()const
+	{
+		return 0;
+	}
+
 	HouGeoAdapter::AttributeAdapter::Type HouGeoAdapter::AttributeAdapter::type( const std::string &typeName )
 	{
 		if( typeName == "numeric" )
@@ -82,9 +113,41 @@ namespace houio
 		else
 		if( storageName == "int32" )
 			return ATTR_STORAGE_INT32;
+		else
+		if( storageName == "fpreal16" )
+			return ATTR_STORAGE_FPREAL16;
+		else
+		if( storageName == "int8" )
+			return ATTR_STORAGE_INT8;
+		else
+		if( storageName == "int16" )
+			return ATTR_STORAGE_INT16;
+		else
+		if( storageName == "int64" )
+			return ATTR_STORAGE_INT64;
+		else
+		if( storageName == "uint8" )
+			return ATTR_STORAGE_UINT8;
 		return ATTR_STORAGE_INVALID;
 	}
 
+	std::string HouGeoAdapter::AttributeAdapter::storageName( Storage storage )
+	{
+		switch(storage)
+		{
+		case ATTR_STORAGE_FPREAL16:return "fpreal16";
+		case ATTR_STORAGE_FPREAL32:return "fpreal32";
+		case ATTR_STORAGE_FPREAL64:return "fpreal64";
+		case ATTR_STORAGE_INT8:return "int8";
+		case ATTR_STORAGE_INT16:return "int16";
+		case ATTR_STORAGE_INT32:return "int32";
+		case ATTR_STORAGE_INT64:return "int64";
+		case ATTR_STORAGE_UINT8:return "uint8";
+		default:break;
+		};
+		return "";
+	}
+
 	int HouGeoAdapter::AttributeAdapter::storageSize( Storage storage )
 	{
 		switch(storage)
@@ -92,6 +155,11 @@ namespace houio
 		case ATTR_STORAGE_FPREAL32:return sizeof(float);break;
 		case ATTR_STORAGE_FPREAL64:return sizeof(double);break;
 		case ATTR_STORAGE_INT32:return sizeof(int);break;
+		case ATTR_STORAGE_FPREAL16:return sizeof(half);break;
+		case ATTR_STORAGE_INT8:return sizeof(sbyte);break;
+		case ATTR_STORAGE_INT16:return sizeof(sint16);break;
+		case ATTR_STORAGE_INT64:return sizeof(sint64);break;
+		case ATTR_STORAGE_UINT8:return sizeof(ubyte);break;
 		default:break;
 		};
 		return 0;
@@ -103,6 +171,11 @@ namespace houio
 	{
 	}
 
+	const int *HouGeoAdapter::Topology::getIndexPointer()const
+	{
+		return 0;
+	}
+
 
 	// HouGeoAdapter::VolumePrimitive ==================================================
 
@@ -118,6 +191,11 @@ namespace houio
 		return HouGeoAdapter::RawPointer::Ptr();
 	}
 
+	const real32 *HouGeoAdapter::VolumePrimitive::getVoxelPointer()const
+	{
+		return 0;
+	}
+
 	// HouGeoAdapter::PolyPrimitive =====================================================
 
 	int HouGeoAdapter::PolyPrimitive::numPolys()const
@@ -140,6 +218,26 @@ namespace houio
 		return false;
 	}
 
+	int HouGeoAdapter::PolyPrimitive::startVertex()const
+	{
+		int numPolys = this->numPolys();
+		if( numPolys == 0 )
+			return -1;
+		const int *first = vertices(0);
+		if( !first || (numVertices(0) == 0) )
+			return -1;
+		int next = first[0];
+		for( int i=0;i<numPolys;++i )
+		{
+			int numVerts = numVertices(i);
+			const int *verts = vertices(i);
+			for( int j=0;j<numVerts;++j,++next )
+				if( verts[j] != next )
+					return -1;
+		}
+		return first[0];
+	}
+
 
 
 	// HouGeoAdapter ==================================================
@@ -200,6 +298,24 @@ namespace houio
 		return HouGeoAdapter::Topology::Ptr();
 	}
 
+	void HouGeoAdapter::getPointGroupNames( std::vector<std::string> &names )const
+	{
+	}
+
+	BitSet::Ptr HouGeoAdapter::getPointGroup( const std::string &name )
+	{
+		return BitSet::Ptr();
+	}
+
+	void HouGeoAdapter::getPrimitiveGroupNames( std::vector<std::string> &names )const
+	{
+	}
+
+	BitSet::Ptr HouGeoAdapter::getPrimitiveGroup( const std::string &name )
+	{
+		return BitSet::Ptr();
+	}
+
 
 
 
@@ -0,0 +1,123 @@
+#include <houio/HouGeoBatch.h>
+#include <houio/HouGeoIO.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+
+
+namespace houio
+{
+	// the json tree, the HouGeo and the Geometry coexist during the conversion and each of them holds about the
+	// uncompressed payload of the file, so the peak is bounded by three times the file size (importing a 107MB and
+	// a 200MB binary file peaks at about twice their size, ascii files parse into less than their size)
+	sint64 HouGeoBatch::estimateMemory( const std::string &path )
+	{
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate );
+		return 3*std::max<sint64>( sint64(in.tellg()), 0 );
+	}
+
+	void HouGeoBatch::importGeometry( const std::vector<std::string> &paths, Callback callback, sint64 memoryBudget, int numThreads, bool triangulate )
+	{
+		if( numThreads <= 0 )
+			numThreads = std::max<int>( 1, std::thread::hardware_concurrency() );
+		numThreads = std::min<int>( numThreads, int(paths.size()) );
+
+		std::mutex mutex;
+		std::condition_variable admitted; // signaled when memory has been released
+		std::condition_variable completed; // signaled when a result is ready
+		std::deque<std::pair<Result, sint64>> results; // finished imports and their memory estimate
+		size_t next = 0; // next file to be taken by a worker
+		size_t nextAdmission = 0; // next file to be admitted, keeps admission in the order the files were taken
+		sint64 memoryInFlight = 0;
+		bool cancelled = false; // set when the callback throws, workers stop taking files
+		std::exception_ptr failure;
+
+		auto worker = [&]()
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			while( !cancelled && (next < paths.size()) )
+			{
+				size_t index = next++;
+
+				// the size is probed without the lock, the file is then admitted in order of its index
+				lock.unlock();
+				sint64 memory = estimateMemory( paths[index] );
+				lock.lock();
+				admitted.wait( lock, [&]{ return cancelled || ((index == nextAdmission)&&((memoryInFlight == 0)||(memoryInFlight + memory <= memoryBudget))); } );
+				if( cancelled )
+					break;
+				++nextAdmission;
+				memoryInFlight += memory;
+				admitted.notify_all();
+				lock.unlock();
+
+				Result result;
+				result.index = index;
+				result.path = paths[index];
+				try
+				{
+					result.geometry = HouGeoIO::importGeometry( paths[index], triangulate );
+					if( !result.geometry )
+						result.error = "failed to import " + paths[index];
+				}catch( std::exception &e )
+				{
+					result.error = e.what();
+				}catch( ... )
+				{
+					result.error = "unknown exception while importing " + paths[index];
+				}
+
+				lock.lock();
+				results.push_back( std::make_pair( result, memory ) );
+				completed.notify_one();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for( int i=0;i<numThreads;++i )
+			threads.push_back( std::thread( worker ) );
+
+		// results are handed out on the calling thread, their memory is released once the callback returns
+		// if the callback throws, the workers are cancelled and joined before the exception is passed on
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			for( size_t numDelivered = 0;numDelivered < paths.size();++numDelivered )
+			{
+				completed.wait( lock, [&]{ return !results.empty(); } );
+				std::pair<Result, sint64> result = results.front();
+				results.pop_front();
+
+				lock.unlock();
+				try
+				{
+					if( callback )
+						callback( result.first );
+				}catch( ... )
+				{
+					failure = std::current_exception();
+				}
+				result.first.geometry.reset();
+				lock.lock();
+
+				memoryInFlight -= result.second;
+				if( failure )
+					cancelled = true;
+				admitted.notify_all();
+				if( failure )
+					break;
+			}
+		}
+
+		for( auto &thread:threads )
+			thread.join();
+
+		if( failure )
+			std::rethrow_exception( failure );
+	}
+}
@@ -0,0 +1,134 @@
+#include <houio/HouGeoExportQueue.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+
+namespace houio
+{
+	namespace
+	{
+		// shares all attributes of geo, attribute data is copied once either side writes to it
+		// the index buffer is a plain vector and gets copied with the geometry
+		Geometry::Ptr snapshot( Geometry::Ptr geo )
+		{
+			Geometry::Ptr copy = std::make_shared<Geometry>( *geo );
+			for( auto &it:copy->m_attributes )
+				if( it.second )
+					it.second = Attribute::createView( it.second, it.second->numComponents() );
+			return copy;
+		}
+
+		// shares the voxel buffer of volume, which is copied once either side writes to it
+		ScalarField::Ptr snapshot( ScalarField::Ptr volume )
+		{
+			return std::make_shared<ScalarField>( *volume );
+		}
+	}
+
+	HouGeoExportQueue::HouGeoExportQueue( int maxQueued, int numThreads ) :
+		m_maxQueued(std::max(maxQueued, 1)),
+		m_numRunning(0),
+		m_stallTime(0.0),
+		m_stop(false)
+	{
+		for( int i=0;i<std::max(numThreads, 1);++i )
+			m_threads.push_back( std::thread( &HouGeoExportQueue::worker, this ) );
+	}
+
+	HouGeoExportQueue::~HouGeoExportQueue()
+	{
+		wait();
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_stop = true;
+		}
+		m_queueCondition.notify_all();
+		for( auto &thread:m_threads )
+			thread.join();
+	}
+
+	HouGeoExportQueue::Ptr HouGeoExportQueue::create( int maxQueued, int numThreads )
+	{
+		return std::make_shared<HouGeoExportQueue>( maxQueued, numThreads );
+	}
+
+	std::future<bool> HouGeoExportQueue::xport( const std::string &filename, HouGeoAdapter::Ptr geo, const Options &options )
+	{
+		return push( [=]{ return HouGeoIO::xport( filename, geo, false, options ); } );
+	}
+
+	std::future<bool> HouGeoExportQueue::xport( const std::string &filename, Geometry::Ptr geo, const Options &options )
+	{
+		Geometry::Ptr copy = snapshot( geo );
+		return push( [=]{ return HouGeoIO::xport( filename, copy, options ); } );
+	}
+
+	std::future<bool> HouGeoExportQueue::xport( const std::string &filename, ScalarField::Ptr volume, const Options &options )
+	{
+		ScalarField::Ptr copy = snapshot( volume );
+		return push( [=]{ return HouGeoIO::xport( filename, copy, options ); } );
+	}
+
+	void HouGeoExportQueue::wait()
+	{
+		std::unique_lock<std::mutex> lock( m_mutex );
+		m_idleCondition.wait( lock, [this]{ return m_queue.empty() && (m_numRunning == 0); } );
+	}
+
+	int HouGeoExportQueue::numPending()const
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		return int(m_queue.size()) + m_numRunning;
+	}
+
+	double HouGeoExportQueue::getStallTime()const
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		return m_stallTime;
+	}
+
+	// exceptions thrown by the export end up in the future
+	std::future<bool> HouGeoExportQueue::push( std::function<bool()> write )
+	{
+		std::packaged_task<bool()> task( write );
+		std::future<bool> result = task.get_future();
+
+		std::unique_lock<std::mutex> lock( m_mutex );
+		if( int(m_queue.size()) >= m_maxQueued )
+		{
+			auto start = std::chrono::steady_clock::now();
+			m_spaceCondition.wait( lock, [this]{ return int(m_queue.size()) < m_maxQueued; } );
+			m_stallTime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+		}
+		m_queue.push_back( std::move(task) );
+		lock.unlock();
+
+		m_queueCondition.notify_one();
+		return result;
+	}
+
+	void HouGeoExportQueue::worker()
+	{
+		std::unique_lock<std::mutex> lock( m_mutex );
+		while( true )
+		{
+			m_queueCondition.wait( lock, [this]{ return m_stop || !m_queue.empty(); } );
+			if( m_queue.empty() )
+				return;
+
+			std::packaged_task<bool()> task = std::move( m_queue.front() );
+			m_queue.pop_front();
+			++m_numRunning;
+			m_spaceCondition.notify_all();
+
+			lock.unlock();
+			task();
+			lock.lock();
+
+			--m_numRunning;
+			m_idleCondition.notify_all();
+		}
+	}
+}
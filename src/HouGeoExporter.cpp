@@ -0,0 +1,892 @@
+#include <houio/HouGeoExporter.h>
+#include <houio/Parallel.h>
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+
+
+namespace houio
+{
+	HouGeoExporter::HouGeoExporter( json::OutputSink *sink, const Options &options ) :
+		m_binaryWriter(0),
+		m_asciiWriter(0)
+	{
+		if( options.binary )
+			m_writer.reset( m_binaryWriter = new json::BinaryWriter( sink ) );
+		else
+			m_writer.reset( m_asciiWriter = new json::ASCIIWriter( sink ) );
+		init( options );
+	}
+
+	HouGeoExporter::HouGeoExporter( std::ostream *out, const Options &options ) :
+		m_binaryWriter(0),
+		m_asciiWriter(0)
+	{
+		if( options.binary )
+			m_writer.reset( m_binaryWriter = new json::BinaryWriter( out ) );
+		else
+			m_writer.reset( m_asciiWriter = new json::ASCIIWriter( out ) );
+		init( options );
+	}
+
+	// a failure can't be returned from here, call flush() before to handle it
+	HouGeoExporter::~HouGeoExporter()
+	{
+		if( !flush() )
+			std::cout << "HouGeoExporter::~HouGeoExporter: warning: flushing the sink failed" << std::endl;
+	}
+
+	void HouGeoExporter::init( const Options &options )
+	{
+		m_options = options;
+		if( m_binaryWriter )
+			m_binaryWriter->setStringInterning( options.internStrings );
+	}
+
+	HouGeoExporter::Ptr HouGeoExporter::create( json::OutputSink *sink, const Options &options )
+	{
+		return std::make_shared<HouGeoExporter>( sink, options );
+	}
+
+	const HouGeoExporter::Options& HouGeoExporter::getOptions()const
+	{
+		return m_options;
+	}
+
+	bool HouGeoExporter::flush()
+	{
+		if( m_binaryWriter )
+			return m_binaryWriter->flush();
+		return m_asciiWriter->flush();
+	}
+
+	void HouGeoExporter::writeUniformBools( const uint32 *bits, sint64 numElements )
+	{
+		if( m_binaryWriter )
+			m_binaryWriter->jsonUniformBoolArray( bits, numElements );
+		else
+			m_asciiWriter->jsonUniformBoolArray( bits, numElements );
+	}
+
+	bool HouGeoExporter::write( HouGeoAdapter::Ptr geo )
+	{
+		m_writer->jsonBeginArray();
+
+		m_writer->jsonString( "pointcount" );
+		m_writer->jsonInt( geo->pointcount() );
+
+		m_writer->jsonString( "vertexcount" );
+		m_writer->jsonInt( geo->vertexcount() );
+
+		m_writer->jsonString( "primitivecount" );
+		m_writer->jsonInt( geo->primitivecount() );
+
+		// -- topology (required)
+		m_writer->jsonString( "topology" );
+		m_writer->jsonBeginArray();
+			if( geo->getTopology() )
+				exportTopology( geo->getTopology() );
+		m_writer->jsonEndArray();
+
+
+		// -- attributes
+		m_writer->jsonString( "attributes" );
+		m_writer->jsonBeginArray();
+
+			// -- point attributes
+			m_writer->jsonString( "pointattributes" );
+			m_writer->jsonBeginArray();
+				std::vector<std::string> pointAttrNames;
+				geo->getPointAttributeNames(pointAttrNames);
+				for( std::vector<std::string>::iterator it = pointAttrNames.begin(); it != pointAttrNames.end(); ++it )
+					exportAttribute( geo->getPointAttribute(*it) );
+			m_writer->jsonEndArray(); // pointattributes
+
+
+			// -- primitive attributes
+			m_writer->jsonString( "primitiveattributes" );
+			m_writer->jsonBeginArray();
+				std::vector<std::string> primitiveAttrNames;
+				geo->getPrimitiveAttributeNames(primitiveAttrNames);
+				for( std::vector<std::string>::iterator it = primitiveAttrNames.begin(); it != primitiveAttrNames.end(); ++it )
+					exportAttribute( geo->getPrimitiveAttribute(*it) );
+			m_writer->jsonEndArray(); // primitiveattributes
+
+/*
+			// -- global attributes
+			m_writer->jsonString( "globalattributes" );
+			m_writer->jsonBeginArray();
+				std::vector<std::string> globalAttrNames;
+				geo->getGlobalAttributeNames(globalAttrNames);
+				for( std::vector<std::string>::iterator it = globalAttrNames.begin(); it != globalAttrNames.end(); ++it )
+					exportAttribute( geo->getGlobalAttribute(*it) );
+			m_writer->jsonEndArray(); // globalattributes
+*/
+		m_writer->jsonEndArray(); // attributes
+
+
+		// -- primitives
+		if( geo->primitivecount() > 0 )
+		{
+			m_writer->jsonString( "primitives" );
+			m_writer->jsonBeginArray();
+
+			std::vector<HouGeoAdapter::Primitive::Ptr> primitives;
+			geo->getPrimitives(primitives);
+
+			for( auto prim : primitives )
+			{
+				if( std::dynamic_pointer_cast<HouGeoAdapter::VolumePrimitive>(prim) )
+					exportPrimitive(std::dynamic_pointer_cast<HouGeoAdapter::VolumePrimitive>(prim));
+				else
+				if( std::dynamic_pointer_cast<HouGeoAdapter::PolyPrimitive>(prim) )
+					exportPrimitive(std::dynamic_pointer_cast<HouGeoAdapter::PolyPrimitive>(prim));
+
+			}
+			m_writer->jsonEndArray(); // primitives
+		}
+
+		// -- groups
+		std::vector<std::string> pointGroupNames;
+		geo->getPointGroupNames(pointGroupNames);
+		if( !pointGroupNames.empty() )
+		{
+			m_writer->jsonString( "pointgroups" );
+			m_writer->jsonBeginArray();
+				for( auto &groupName : pointGroupNames )
+					exportGroup( groupName, geo->getPointGroup(groupName), geo->pointcount() );
+			m_writer->jsonEndArray(); // pointgroups
+		}
+
+		std::vector<std::string> primitiveGroupNames;
+		geo->getPrimitiveGroupNames(primitiveGroupNames);
+		if( !primitiveGroupNames.empty() )
+		{
+			m_writer->jsonString( "primitivegroups" );
+			m_writer->jsonBeginArray();
+				for( auto &groupName : primitiveGroupNames )
+					exportGroup( groupName, geo->getPrimitiveGroup(groupName), geo->primitivecount() );
+			m_writer->jsonEndArray(); // primitivegroups
+		}
+
+
+
+		m_writer->jsonEndArray(); // /root
+
+		return flush();
+	}
+
+
+
+
+
+
+	namespace
+	{
+		// true if pack components [0, packSize) of all numElements tuples are bitwise equal
+		template<typename T>
+		bool isConstantPack( const T *data, sint64 numElements, int tupleSize, int packSize )
+		{
+			for( sint64 i=1;i<numElements;++i )
+				if( memcmp( data + i*tupleSize, data, packSize*sizeof(T) ) != 0 )
+					return false;
+			return true;
+		}
+	}
+
+	// writes packing, constantpageflags and rawpagedata of a numeric attribute
+	// packs which are constant within a page only store the values of the first element of that page
+	// the flags are determined in a first pass so that the pages can be written without copying the attribute
+	template<typename T>
+	void HouGeoExporter::writePages( const T *data, sint64 numElements, int tupleSize, const std::vector<int> &packing, sint64 pageSize, bool constantPages )
+	{
+		sint64 numPages = (numElements + pageSize - 1)/pageSize;
+		std::vector<std::vector<uint32>> flags( packing.size(), std::vector<uint32>( std::max<sint64>( (numPages+31)/32, 1 ), 0 ) );
+		bool hasConstantPages = false;
+		sint64 numComponents = 0;
+		for( sint64 page=0;page<numPages;++page )
+		{
+			sint64 first = page*pageSize;
+			sint64 count = std::min( pageSize, numElements - first );
+			int startComponent = 0;
+			for( size_t pack=0;pack<packing.size();++pack )
+			{
+				if( constantPages && isConstantPack( data + first*tupleSize + startComponent, count, tupleSize, packing[pack] ) )
+				{
+					flags[pack][page >> 5] |= 1u << (page & 31);
+					hasConstantPages = true;
+					numComponents += packing[pack];
+				}else
+					numComponents += count*packing[pack];
+				startComponent += packing[pack];
+			}
+		}
+
+		if( packing.size() > 1 )
+		{
+			m_writer->jsonString( "packing" );
+			writeUniform<sint32>( packing.data(), sint64(packing.size()) );
+		}
+
+		if( hasConstantPages )
+		{
+			m_writer->jsonString( "constantpageflags" );
+			m_writer->jsonBeginArray();
+			for( auto &packFlags:flags )
+				writeUniformBools( &packFlags[0], numPages );
+			m_writer->jsonEndArray();
+		}
+
+		// binary output is streamed page by page, ascii output is gathered and written in one go
+		std::vector<T> gathered;
+		auto emit = [&]( const T *values, sint64 count )
+		{
+			if( m_binaryWriter )
+				m_binaryWriter->write<T>( values, count );
+			else
+				gathered.insert( gathered.end(), values, values + count );
+		};
+
+		m_writer->jsonString( "rawpagedata" );
+		if( m_binaryWriter )
+			m_binaryWriter->jsonBeginUniformArray( json::BinaryWriter::uniformType<T>(), numComponents );
+		else
+			gathered.reserve( numComponents );
+		std::vector<T> buffer;
+		for( sint64 page=0;page<numPages;++page )
+		{
+			sint64 first = page*pageSize;
+			sint64 count = std::min( pageSize, numElements - first );
+			int startComponent = 0;
+			for( size_t pack=0;pack<packing.size();++pack )
+			{
+				int packSize = packing[pack];
+				const T *src = data + first*tupleSize + startComponent;
+				if( flags[pack][page >> 5] & (1u << (page & 31)) )
+					emit( src, packSize );
+				else
+				if( packSize == tupleSize )
+					emit( src, count*tupleSize );
+				else
+				{
+					buffer.resize( count*packSize );
+					for( sint64 i=0;i<count;++i )
+						std::copy( src + i*tupleSize, src + i*tupleSize + packSize, &buffer[i*packSize] );
+					emit( &buffer[0], count*packSize );
+				}
+				startComponent += packSize;
+			}
+		}
+		if( m_asciiWriter )
+			m_asciiWriter->jsonUniformArray<T>( gathered.data(), sint64(gathered.size()) );
+	}
+
+	bool HouGeoExporter::exportAttribute( HouGeoAdapter::AttributeAdapter::Ptr attr )
+	{
+		if( !attr )
+			return false;
+
+		std::string type;
+		std::string storage;
+		int size = attr->getTupleSize();
+		std::string name = attr->getName();
+
+		if( attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_NUMERIC )
+			type = "numeric";
+		else if( attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_STRING )
+			type = "string";
+
+		storage = HouGeoAdapter::AttributeAdapter::storageName( attr->getStorage() );
+
+
+		// P attribute has to have 4 components, otherwise houdini will become unstable and eventually crash
+		if( (name == "P")&&(size!=4)  )
+			throw std::runtime_error( "HouGeoExporter::exportAttribute: P attribute has to have 4 components, otherwise houdini will become unstable and eventually crash" );
+
+		m_writer->jsonBeginArray();
+
+
+		// attribute definition ------------
+		m_writer->jsonBeginArray();
+
+		m_writer->jsonString( "name" );
+		m_writer->jsonString( name );
+
+		m_writer->jsonString( "type" );
+		m_writer->jsonString(type);
+
+		m_writer->jsonEndArray(); // definition
+
+		// attribute content ------------
+		m_writer->jsonBeginArray();
+
+		if( attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_NUMERIC )
+		{
+			m_writer->jsonString( "size" );
+			m_writer->jsonInt( size );
+
+			m_writer->jsonString( "storage" );
+			m_writer->jsonString( storage );
+
+
+			m_writer->jsonString( "values" );
+			m_writer->jsonBeginArray();
+
+				m_writer->jsonString( "size" );
+				m_writer->jsonInt( attr->getTupleSize() );
+
+				m_writer->jsonString( "storage" );
+				m_writer->jsonString( storage );
+
+				m_writer->jsonString( "pagesize" );
+				m_writer->jsonInt( 1024 );
+
+
+				std::vector<int> packing;
+				if( m_options.splitPacking && (size == 4) )
+				{
+					packing.push_back( 3 );
+					packing.push_back( 1 );
+				}else
+					packing.push_back( size );
+
+				// adapters which dont provide packed data for reading are read through getRawPointer
+				const void *rawData = attr->getDataPointer();
+				HouGeoAdapter::RawPointer::Ptr raw;
+				if( !rawData && (raw = attr->getRawPointer()) )
+					rawData = raw->ptr;
+				sint64 numElements = attr->getNumElements();
+				bool constantPages = m_options.constantPages;
+				switch( attr->getStorage() )
+				{
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL16:writePages<real16>( (const real16*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32:writePages<real32>( (const real32*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL64:writePages<real64>( (const real64*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT8:writePages<sbyte>( (const sbyte*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT16:writePages<sint16>( (const sint16*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT32:writePages<sint32>( (const sint32*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT64:writePages<sint64>( (const sint64*) rawData, numElements, size, packing, 1024, constantPages );break;
+				case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_UINT8:writePages<ubyte>( (const ubyte*) rawData, numElements, size, packing, 1024, constantPages );break;
+				default:
+					throw std::runtime_error( "HouGeoExporter::exportAttribute: unsupported storage for attribute " + name );
+				};
+
+			m_writer->jsonEndArray(); // values
+		}else
+		if(attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_STRING )
+		{
+			m_writer->jsonString( "size" );
+			m_writer->jsonInt( size );
+
+			m_writer->jsonString( "storage" );
+			m_writer->jsonString( "int32" );
+
+			// unique strings, elements reference them by index
+			// the table is read in place if the attribute keeps one, otherwise it is built from getString
+			std::vector<std::string> stringStorage;
+			std::vector<sint32> indexStorage;
+			const std::vector<std::string> *strings = attr->getStrings();
+			const std::vector<sint32> *indices = attr->getStringIndices();
+			if( !strings || !indices )
+			{
+				attr->getStringTable( stringStorage, indexStorage );
+				strings = &stringStorage;
+				indices = &indexStorage;
+			}
+
+			m_writer->jsonString( "strings" );
+			m_writer->jsonBeginArray();
+				for( auto &string:*strings )
+					m_writer->jsonString( string );
+			m_writer->jsonEndArray();
+
+			m_writer->jsonString( "indices" );
+			m_writer->jsonBeginArray();
+				m_writer->jsonString( "size" );
+				m_writer->jsonInt32( 1 );
+
+				m_writer->jsonString( "storage" );
+				m_writer->jsonString( "int32" );
+
+				m_writer->jsonString( "pagesize" );
+				m_writer->jsonInt32( 1024 );
+
+				writePages<sint32>( indices->data(), sint64(indices->size()), 1, std::vector<int>( 1, 1 ), 1024, m_options.constantPages );
+
+			m_writer->jsonEndArray();
+
+
+		}
+
+
+
+		m_writer->jsonEndArray(); // attribute content
+
+
+
+		m_writer->jsonEndArray(); // attribute
+
+		return true;
+	}
+
+	// groups are written as bitstream
+	// houdini expects one bit per element (point or primitive) of the geometry
+	bool HouGeoExporter::exportGroup( const std::string &name, BitSet::Ptr group, sint64 numElements )
+	{
+		if( !group )
+			return false;
+		if( sint64(group->size()) != numElements )
+			throw std::runtime_error( "HouGeoExporter::exportGroup: group " + name + " doesnt match the number of elements" );
+
+		m_writer->jsonBeginArray();
+
+		// group definition ------------
+		m_writer->jsonBeginArray();
+			m_writer->jsonString( "name" );
+			m_writer->jsonString( name );
+		m_writer->jsonEndArray(); // definition
+
+		// group content ------------
+		m_writer->jsonBeginArray();
+			m_writer->jsonString( "selection" );
+			m_writer->jsonBeginArray();
+				m_writer->jsonString( "defaults" );
+				m_writer->jsonBeginArray();
+					m_writer->jsonString( "size" );
+					m_writer->jsonInt( 1 );
+					m_writer->jsonString( "storage" );
+					m_writer->jsonString( "int8" );
+					m_writer->jsonString( "value" );
+					m_writer->jsonBeginArray();
+						m_writer->jsonInt( 0 );
+					m_writer->jsonEndArray();
+				m_writer->jsonEndArray(); // defaults
+
+				m_writer->jsonString( "unordered" );
+				m_writer->jsonBeginArray();
+					m_writer->jsonString( "i8" );
+					writeUniformBools( group->getRawPointer(), group->size() );
+				m_writer->jsonEndArray(); // unordered
+			m_writer->jsonEndArray(); // selection
+		m_writer->jsonEndArray(); // content
+
+		m_writer->jsonEndArray(); // group
+
+		return true;
+	}
+
+	// export topo
+	// indices are written straight from the topology if it exposes them, otherwise from a copy
+	bool HouGeoExporter::exportTopology( HouGeoAdapter::Topology::Ptr topo )
+	{
+		std::vector<sint32> copy;
+		const sint32 *indices = topo->getIndexPointer();
+		sint64 numIndices = topo->getNumIndices();
+		if( !indices )
+		{
+			topo->getIndices(copy);
+			indices = copy.data();
+			numIndices = sint64(copy.size());
+		}
+
+		// the index array is written with 16 bit integers if all indices fit
+		// indices are narrowed while they are checked, the first one which doesnt fit ends the narrowing
+		std::vector<sint16> narrowed;
+		bool index_exceeds_16bit = m_asciiWriter != 0;
+		if( !index_exceeds_16bit )
+		{
+			narrowed.resize( size_t(numIndices) );
+			for( sint64 i=0;i<numIndices;++i )
+			{
+				if( indices[i] > std::numeric_limits<sint16>::max() )
+				{
+					index_exceeds_16bit = true;
+					break;
+				}
+				narrowed[size_t(i)] = sint16(indices[i]);
+			}
+		}
+
+		m_writer->jsonString( "pointref" );
+		m_writer->jsonBeginArray();
+			m_writer->jsonString( "indices" );
+			if( index_exceeds_16bit )
+				writeUniform<sint32>( indices, numIndices );
+			else
+				writeUniform<sint16>( narrowed.data(), numIndices );
+
+		m_writer->jsonEndArray();
+
+		return true;
+	}
+
+
+	namespace
+	{
+		// indices into the compressiontypes list of exported volumes
+		enum TileCompression
+		{
+			TILE_RAW = 0,
+			TILE_RAWFULL = 1,
+			TILE_CONSTANT = 2,
+			TILE_FPREAL16 = 3
+		};
+
+		// voxel data of a single tile of an exported volume
+		struct EncodedTile
+		{
+			TileCompression                           compression;
+			real32                                    constant; // value of constant tiles
+			std::vector<real32>                       data;
+			std::vector<real16>                       halfData; // data of fpreal16 tiles
+		};
+
+		// joins the thread when leaving the scope, also when writing throws while the thread is still running
+		struct ThreadJoiner
+		{
+			ThreadJoiner( std::thread &thread ) : thread(thread)
+			{
+			}
+			~ThreadJoiner()
+			{
+				if( thread.joinable() )
+					thread.join();
+			}
+			std::thread                               &thread;
+		};
+
+		// true if all values are bitwise equal or, with a tolerance, lie within tolerance of each other (nan never does)
+		bool isConstant( const std::vector<real32> &data, real32 tolerance, real32 &value )
+		{
+			real32 lo = data[0];
+			real32 hi = data[0];
+			if( tolerance <= 0.0f )
+			{
+				for( auto v:data )
+					if( memcmp( &v, &lo, sizeof(real32) ) != 0 )
+						return false;
+			}else
+			{
+				for( auto v:data )
+				{
+					if( v != v )
+						return false;
+					lo = std::min( lo, v );
+					hi = std::max( hi, v );
+					if( !(hi - lo <= tolerance) )
+						return false;
+				}
+			}
+			value = lo + (hi - lo)*0.5f;
+			return true;
+		}
+
+		// gathers the voxels of tile t (x varies fastest within the tile) and picks its compression
+		// scanlines are copied from voxels if given, otherwise the voxels are queried one by one
+		void encodeTile( HouGeoAdapter::VolumePrimitive *volume, const real32 *voxels, const math::V3i &res, const math::Vec3i &tileEnd, sint64 t, const HouGeoIO::ExportOptions &options, EncodedTile &tile )
+		{
+			math::V3i voxelOffset( int(t%tileEnd.x)*16, int((t/tileEnd.x)%tileEnd.y)*16, int(t/(sint64(tileEnd.x)*tileEnd.y))*16 );
+			math::V3i numVoxels( std::min( 16, res.x - voxelOffset.x ), std::min( 16, res.y - voxelOffset.y ), std::min( 16, res.z - voxelOffset.z ) );
+
+			tile.compression = TILE_RAW;
+			tile.data.resize( numVoxels.x*numVoxels.y*numVoxels.z );
+			real32 *dst = tile.data.empty() ? 0 : &tile.data[0];
+			for( int k=voxelOffset.z;k<voxelOffset.z+numVoxels.z;++k )
+				for( int j=voxelOffset.y;j<voxelOffset.y+numVoxels.y;++j )
+				{
+					if( voxels )
+						memcpy( dst, voxels + (sint64(k)*res.y + j)*res.x + voxelOffset.x, numVoxels.x*sizeof(real32) );
+					else
+						for( int i=0;i<numVoxels.x;++i )
+							dst[i] = volume->getVoxel( voxelOffset.x + i, j, k );
+					dst += numVoxels.x;
+				}
+
+			if( options.constantTiles && isConstant( tile.data, options.tolerance, tile.constant ) )
+				tile.compression = TILE_CONSTANT;
+			else
+			if( options.halfPrecisionTiles )
+			{
+				tile.compression = TILE_FPREAL16;
+				tile.halfData.resize( tile.data.size() );
+				for( size_t i=0;i<tile.data.size();++i )
+					tile.halfData[i] = real16( tile.data[i] );
+			}
+		}
+	}
+
+	bool HouGeoExporter::exportPrimitive( HouGeoAdapter::VolumePrimitive::Ptr volume )
+	{
+		math::V3i res = volume->getResolution();
+
+		m_writer->jsonBeginArray();
+
+		// primitive type
+		m_writer->jsonBeginArray();
+			m_writer->jsonString("type");
+			m_writer->jsonString("Volume");
+		m_writer->jsonEndArray();
+
+		m_writer->jsonBeginArray();
+			m_writer->jsonString("vertex");
+			m_writer->jsonInt32(volume->getVertex());
+
+			m_writer->jsonString("transform");
+			math::M44f houLocalToWorldTranslation = math::M44f::TranslationMatrix(volume->getTransform().getTranslation());
+			math::M44f houLocalToWorldRotationScale = math::M44f::ScaleMatrix(0.5f)*math::M44f::TranslationMatrix(1.0,1.0,1.0)*volume->getTransform()*houLocalToWorldTranslation.inverted();
+			math::M33f transform( houLocalToWorldRotationScale.ma[0], houLocalToWorldRotationScale.ma[1], houLocalToWorldRotationScale.ma[2],
+						houLocalToWorldRotationScale.ma[4], houLocalToWorldRotationScale.ma[5], houLocalToWorldRotationScale.ma[6],
+						houLocalToWorldRotationScale.ma[8], houLocalToWorldRotationScale.ma[9], houLocalToWorldRotationScale.ma[10]);
+			writeUniform<real32>( transform.ma, 9 );
+
+			m_writer->jsonString("res");
+			writeUniform<sint32>( &res.x, 3 );
+
+			m_writer->jsonString("border");
+			m_writer->jsonBeginMap();
+				m_writer->jsonKey("type");
+				m_writer->jsonString("constant");
+				m_writer->jsonKey("value");
+				m_writer->jsonReal32(0.0f);
+			m_writer->jsonEndMap();
+
+			m_writer->jsonString("compression");
+			m_writer->jsonBeginMap();
+				m_writer->jsonKey("tolerance");
+				m_writer->jsonReal32( m_options.constantTiles ? std::max( m_options.tolerance, 0.0f ) : 0.0f );
+			m_writer->jsonEndMap();
+
+			m_writer->jsonString("voxels");
+			m_writer->jsonBeginArray();
+				m_writer->jsonString("tiledarray");
+				m_writer->jsonBeginArray();
+					m_writer->jsonString("version");
+					m_writer->jsonInt32( 1 );
+
+					m_writer->jsonString("compressiontypes");
+					// !!! uniform string array?
+					m_writer->jsonBeginArray();
+						m_writer->jsonString("raw");
+						m_writer->jsonString("rawfull");
+						m_writer->jsonString("constant");
+						m_writer->jsonString("fpreal16");
+						m_writer->jsonString("FP32Range");
+					m_writer->jsonEndArray();
+
+					m_writer->jsonString("tiles");
+					m_writer->jsonBeginArray();
+
+						// get first invalid tileindex in each dimension
+						math::Vec3i tileEnd;
+						tileEnd.x = res.x / 16;
+						tileEnd.y = res.y / 16;
+						tileEnd.z = res.z / 16;
+
+						// if there are some voxels remaining, add another tile
+						if( res.x%16 )
+							++tileEnd.x;
+						if( res.y%16 )
+							++tileEnd.y;
+						if( res.z%16 )
+							++tileEnd.z;
+
+						// tiles are encoded in batches, the next batch is encoded in parallel while the current one is written
+						// without raw voxel data, getVoxel is called from the calling thread only
+						// adapters which only provide getRawPointer are read through it
+						const real32 *voxels = volume->getVoxelPointer();
+						HouGeoAdapter::RawPointer::Ptr raw;
+						if( !voxels && (raw = volume->getRawPointer()) )
+							voxels = (const real32 *)raw->ptr;
+						const sint64 numTiles = sint64(tileEnd.x)*tileEnd.y*tileEnd.z;
+						const sint64 batchSize = 1024;
+						std::vector<EncodedTile> batches[2];
+						batches[0].resize( std::min( batchSize, numTiles ) );
+						batches[1].resize( std::min( batchSize, numTiles ) );
+
+						// encoding runs on worker threads, the first exception is kept and rethrown on the calling thread
+						std::mutex errorMutex;
+						std::exception_ptr error;
+						auto encodeBatch = [&]( sint64 batchBegin, std::vector<EncodedTile> &batch )
+						{
+							sint64 batchEnd = std::min( batchBegin + batchSize, numTiles );
+							auto encode = [&]( sint64 begin, sint64 end )
+							{
+								try
+								{
+									for( sint64 t=begin;t<end;++t )
+										encodeTile( volume.get(), voxels, res, tileEnd, t, m_options, batch[t - batchBegin] );
+								}catch( ... )
+								{
+									std::lock_guard<std::mutex> lock( errorMutex );
+									if( !error )
+										error = std::current_exception();
+								}
+							};
+							if( voxels )
+								parallelFor( batchBegin, batchEnd, encode, 16 );
+							else
+								encode( batchBegin, batchEnd );
+						};
+
+						if( numTiles > 0 )
+							encodeBatch( 0, batches[0] );
+						if( error )
+							std::rethrow_exception( error );
+						for( sint64 batchBegin=0;batchBegin<numTiles;batchBegin+=batchSize )
+						{
+							std::vector<EncodedTile> &batch = batches[(batchBegin/batchSize)%2];
+							sint64 nextBegin = batchBegin + batchSize;
+							std::thread next;
+							ThreadJoiner joiner( next );
+							if( voxels && (nextBegin < numTiles) )
+								next = std::thread( encodeBatch, nextBegin, std::ref(batches[(nextBegin/batchSize)%2]) );
+
+							sint64 batchEnd = std::min( nextBegin, numTiles );
+							for( sint64 t=batchBegin;t<batchEnd;++t )
+							{
+								const EncodedTile &tile = batch[t - batchBegin];
+								m_writer->jsonBeginArray();
+									m_writer->jsonString("compression");
+									m_writer->jsonInt32(tile.compression);
+									m_writer->jsonString("data");
+									if( tile.compression == TILE_CONSTANT )
+										m_writer->jsonReal32(tile.constant);
+									else
+									if( tile.compression == TILE_FPREAL16 )
+										writeUniform<real16>( tile.halfData.data(), sint64(tile.halfData.size()) );
+									else
+										writeUniform<real32>( tile.data.data(), sint64(tile.data.size()) );
+								m_writer->jsonEndArray();
+							}
+
+							if( next.joinable() )
+								next.join();
+							else
+							if( nextBegin < numTiles )
+								encodeBatch( nextBegin, batches[(nextBegin/batchSize)%2] );
+							if( error )
+								std::rethrow_exception( error );
+						}
+
+					m_writer->jsonEndArray();
+
+				m_writer->jsonEndArray();
+
+			m_writer->jsonEndArray();
+
+			m_writer->jsonString("visualization");
+			m_writer->jsonBeginMap();
+				m_writer->jsonKey("mode");
+				m_writer->jsonString("smoke");
+				m_writer->jsonKey("iso");
+				m_writer->jsonReal32(0.0f);
+				m_writer->jsonKey("density");
+				m_writer->jsonReal32(1.0f);
+			m_writer->jsonEndMap();
+
+			m_writer->jsonString("taperx");
+			m_writer->jsonReal32(1.0f);
+
+			m_writer->jsonString("tapery");
+			m_writer->jsonReal32(1.0f);
+
+
+
+		m_writer->jsonEndArray();
+
+		m_writer->jsonEndArray();
+		return true;
+	}
+
+	bool HouGeoExporter::exportPrimitive( HouGeoAdapter::PolyPrimitive::Ptr poly )
+	{
+		// if we have a single polygon, then we just export it as is
+		// closed polygons with sequentially numbered vertices are written as compact run (vertices are implicit)
+		int startVertex = (m_options.polygonRuns && (poly->numPolys() > 1) && poly->closed()) ? poly->startVertex() : -1;
+
+		m_writer->jsonBeginArray();
+			if( startVertex >= 0 )
+			{
+				// vertex counts are run length encoded as pairs of vertex count and number of polygons
+				std::vector<sint32> vertexCounts;
+				int numPolys = poly->numPolys();
+				for( int i=0;i<numPolys;++i )
+				{
+					int numVertices = poly->numVertices(i);
+					if( vertexCounts.empty() || (vertexCounts[vertexCounts.size()-2] != numVertices) )
+					{
+						vertexCounts.push_back( numVertices );
+						vertexCounts.push_back( 0 );
+					}
+					++vertexCounts.back();
+				}
+
+				m_writer->jsonBeginArray();
+					m_writer->jsonString("type");
+					m_writer->jsonString("Polygon_run");
+				m_writer->jsonEndArray();
+
+				m_writer->jsonBeginArray();
+					m_writer->jsonString("startvertex");
+					m_writer->jsonInt( startVertex );
+					m_writer->jsonString("nprimitives");
+					m_writer->jsonInt( numPolys );
+					m_writer->jsonString("nvertices_rle");
+					writeUniform<sint32>( vertexCounts.data(), sint64(vertexCounts.size()) );
+				m_writer->jsonEndArray();
+			}else
+			if( poly->numPolys() == 1 )
+			{
+				// single poly
+				m_writer->jsonBeginArray();
+					m_writer->jsonString("type");
+					m_writer->jsonString("Poly");
+				m_writer->jsonEndArray();
+
+				m_writer->jsonBeginArray();
+					m_writer->jsonString("vertex");
+					writeUniform<sint32>( poly->vertices(0), poly->numVertices(0) );
+
+					m_writer->jsonString("closed");
+					m_writer->jsonBool(false);
+				m_writer->jsonEndArray();
+			}else
+			{
+				// polygon run
+				m_writer->jsonBeginArray();
+					m_writer->jsonString("type");
+					m_writer->jsonString("run");
+					m_writer->jsonString("runtype");
+					m_writer->jsonString("Poly");
+					m_writer->jsonString("varyingfields");
+					m_writer->jsonBeginArray();
+						m_writer->jsonString("vertex");
+					m_writer->jsonEndArray();
+					m_writer->jsonString("uniformfields");
+					m_writer->jsonBeginMap();
+						m_writer->jsonKey("closed");
+						m_writer->jsonBool(poly->closed());
+					m_writer->jsonEndMap();
+				m_writer->jsonEndArray();
+
+				m_writer->jsonBeginArray();
+					int numPolys = poly->numPolys();
+					for( int i=0;i<numPolys;++i )
+					{
+						m_writer->jsonBeginArray();
+							writeUniform<sint32>( poly->vertices(i), poly->numVertices(i) );
+						m_writer->jsonEndArray();
+					}
+				m_writer->jsonEndArray();
+			}
+
+		m_writer->jsonEndArray();
+		return true;
+	}
+}
@@ -1,11 +1,16 @@
 #include <houio/HouGeoIO.h>
+#include <houio/HouGeoExporter.h>
+#include <houio/HouGeoPointWriter.h>
+#include <houio/Parallel.h>
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
 
 
 
 namespace houio
 {
-	HouGeoAdapter*                  HouGeoIO::g_geo = 0;
-	json::BinaryWriter*             HouGeoIO::g_writer = 0;
 
 	HouGeo::Ptr HouGeoIO::import( std::istream *in )
 	{
@@ -32,11 +37,15 @@ namespace houio
 		return houGeo;
 	}
 
-	Geometry::Ptr HouGeoIO::importGeometry( const std::string &path )
+	Geometry::Ptr HouGeoIO::importGeometry( const std::string &path, bool triangulate )
 	{
-		Geometry::Ptr result;
 		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
-		HouGeo::Ptr hgeo = HouGeoIO::import( &in );
+		return importGeometry( HouGeoIO::import( &in ), triangulate );
+	}
+
+	Geometry::Ptr HouGeoIO::importGeometry( HouGeo::Ptr hgeo, bool triangulate )
+	{
+		Geometry::Ptr result;
 		if( hgeo )
 		{
 			std::vector<HouGeoAdapter::Primitive::Ptr> primitives;
@@ -52,7 +61,7 @@ namespace houio
 			{
 				prim = primitives[0];
 				if(std::dynamic_pointer_cast<HouGeo::HouPoly>(prim) )
-					result = convertToGeometry(hgeo, prim);
+					result = convertToGeometry(hgeo, prim, triangulate);
 			}else
 				// no valid primitive to convert
 				// we pass an invalid point to get some default geometry created
@@ -85,7 +94,7 @@ namespace houio
 			if(std::dynamic_pointer_cast<HouGeo::HouVolume>(prim) )
 			{
 				HouGeo::HouVolume::Ptr houVolume = std::dynamic_pointer_cast<HouGeo::HouVolume>(prim);
-				result = houVolume->field;
+				result = houVolume->getField();
 			}
 		}else
 		{
@@ -94,8 +103,264 @@ namespace houio
 		return result;
 	}
 
+	// binary files are parsed without the payload of the volume tiles, tiles which intersect the region are parsed through the index
+	ScalarField::Ptr HouGeoIO::importVolume( const std::string &path, const math::Box3f &region, bool voxelSpace )
+	{
+		ScalarField::Ptr result;
+		HouGeoIndex::Ptr index;
+		if( HouGeoIndex::isIndexable( path ) )
+			index = HouGeoIndex::load( path, false );
+
+		std::shared_ptr<std::ifstream> in = std::make_shared<std::ifstream>( path.c_str(), std::ios_base::in | std::ios_base::binary );
+		json::JSONReader reader;
+		if( index )
+			for( auto &entry:index->entries )
+				if( (entry.type == HouGeoIndex::ENTRY_VOLUME_TILE)&&(entry.dataOffset >= 0) )
+					reader.skippedPayloads.insert( entry.dataOffset );
+		json::Parser p;
+		if( !p.parse( in.get(), &reader ) )
+		{
+			std::cout << "HouGeoIO::importVolume: failed to import houGeo\n";
+			return result;
+		}
+
+		// the region is applied while the volume primitives are being loaded
+		HouGeo::Ptr hgeo = HouGeo::create();
+		hgeo->setVolumeRegion( region, voxelSpace );
+		if( index )
+			hgeo->setTileLoader( HouGeoIndex::tileLoader( index, in ) );
+		hgeo->load( HouGeo::toObject(reader.getRoot().asArray()) );
+
+		std::vector<HouGeoAdapter::Primitive::Ptr> primitives;
+		hgeo->getPrimitives(primitives);
+		HouGeo::HouVolume::Ptr houVolume = primitives.empty() ? HouGeo::HouVolume::Ptr() : std::dynamic_pointer_cast<HouGeo::HouVolume>(primitives[0]);
+		if( houVolume )
+		{
+			// region doesnt intersect the volume
+			math::V3i res = houVolume->getResolution();
+			if( (res.x>0)&&(res.y>0)&&(res.z>0) )
+				result = houVolume->getField();
+		}
+		return result;
+	}
+
+	// volumes are returned undecoded - voxel data is decoded on first call to HouVolume::getField
+	HouGeo::Ptr HouGeoIO::importVolumes( const std::string &path, std::vector<HouGeo::HouVolume::Ptr>& volumes )
+	{
+		volumes.clear();
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+		json::JSONReader reader;
+		json::Parser p;
+		if( !p.parse( &in, &reader ) )
+		{
+			std::cout << "HouGeoIO::importVolumes: failed to import houGeo\n";
+			return HouGeo::Ptr();
+		}
+
+		HouGeo::Ptr hgeo = HouGeo::create();
+		hgeo->setLazyVolumeLoading( true );
+		hgeo->load( HouGeo::toObject(reader.getRoot().asArray()) );
+		hgeo->getVolumes( volumes );
+		return hgeo;
+	}
+
+	// only the volume with given name is decoded
+	ScalarField::Ptr HouGeoIO::importVolume( const std::string &path, const std::string &name )
+	{
+		std::vector<HouGeo::HouVolume::Ptr> volumes;
+		HouGeo::Ptr hgeo = importVolumes( path, volumes );
+		if( !hgeo )
+			return ScalarField::Ptr();
+		HouGeo::HouVolume::Ptr vol = hgeo->getVolume( name );
+		if( !vol )
+		{
+			std::cout << "HouGeoIO::importVolume: volume " << name << " not found\n";
+			return ScalarField::Ptr();
+		}
+		return vol->getField();
+	}
+
+	// returns the data of the given attribute - data of HouGeo attributes is shared instead of copied
+	static Attribute::Ptr sourceAttribute( HouGeoAdapter::AttributeAdapter::Ptr houAttr )
+	{
+		HouGeo::HouAttribute::Ptr hattr = std::dynamic_pointer_cast<HouGeo::HouAttribute>(houAttr);
+		if( hattr && hattr->m_attr )
+			return hattr->m_attr;
+		Attribute::ComponentType componentType = Attribute::componentType( HouGeoAdapter::AttributeAdapter::storageName(houAttr->getStorage()) );
+		if( componentType == Attribute::INVALID )
+			return Attribute::Ptr();
+		return Attribute::create( houAttr->getTupleSize(), componentType, (unsigned char *)houAttr->getRawPointer()->ptr, houAttr->getNumElements() );
+	}
+
+	// positions and uvs are always float in Geometry - other storages are converted explicitly
+	static Attribute::Ptr floatAttribute( HouGeoAdapter::AttributeAdapter::Ptr houAttr )
+	{
+		Attribute::Ptr attr = sourceAttribute( houAttr );
+		if( attr && (attr->elementComponentType() != Attribute::FLOAT) )
+			attr = attr->convert( Attribute::FLOAT );
+		return attr;
+	}
+
+	// twice the signed area of the 2d triangle p0, p1, p2
+	static float orient2d( const math::V2f &p0, const math::V2f &p1, const math::V2f &p2 )
+	{
+		return (p1.x-p0.x)*(p2.y-p0.y) - (p1.y-p0.y)*(p2.x-p0.x);
+	}
+
+	// triangulates a single polygon into numVertices-2 triangles
+	// convex polygons are fanned, concave polygons are ear clipped in the plane of their newell normal
+	// positions and remaining are scratch buffers which are reused between polygons
+	static void triangulatePoly( const int *vertices, int numVertices, Attribute::CPtr pAttr, unsigned int *out, std::vector<math::V3f> &positions, std::vector<math::V2f> &projected, std::vector<int> &remaining )
+	{
+		bool convex = true;
+		if( (numVertices > 3) && pAttr )
+		{
+			positions.resize( numVertices );
+			for( int i=0;i<numVertices;++i )
+				positions[i] = pAttr->get<math::V3f>( vertices[i] );
+
+			math::V3f normal( 0.0f );
+			for( int i=0;i<numVertices;++i )
+			{
+				const math::V3f &p0 = positions[i];
+				const math::V3f &p1 = positions[(i+1)%numVertices];
+				normal.x += (p0.y - p1.y)*(p0.z + p1.z);
+				normal.y += (p0.z - p1.z)*(p0.x + p1.x);
+				normal.z += (p0.x - p1.x)*(p0.y + p1.y);
+			}
+
+			for( int i=0;i<numVertices;++i )
+			{
+				const math::V3f &p0 = positions[(i+numVertices-1)%numVertices];
+				const math::V3f &p1 = positions[i];
+				const math::V3f &p2 = positions[(i+1)%numVertices];
+				if( math::dot( math::cross( p1-p0, p2-p1 ), normal ) < 0.0f )
+				{
+					convex = false;
+					break;
+				}
+			}
+
+			if( !convex )
+			{
+				// project onto the plane spanned by the two non dominant axes
+				// the axes are swapped if required so that the polygon is counter clockwise in 2d
+				int axis = 2;
+				if( (std::abs(normal.x) >= std::abs(normal.y))&&(std::abs(normal.x) >= std::abs(normal.z)) )
+					axis = 0;
+				else
+				if( std::abs(normal.y) >= std::abs(normal.z) )
+					axis = 1;
+				int u = (axis+1)%3;
+				int v = (axis+2)%3;
+				if( normal[axis] < 0.0f )
+					std::swap( u, v );
+				projected.resize( numVertices );
+				for( int i=0;i<numVertices;++i )
+					projected[i] = math::V2f( positions[i][u], positions[i][v] );
+			}
+		}
+
+		if( convex )
+		{
+			for( int i=1;i<numVertices-1;++i )
+			{
+				*out++ = vertices[0];
+				*out++ = vertices[i];
+				*out++ = vertices[i+1];
+			}
+			return;
+		}
+
+		remaining.resize( numVertices );
+		for( int i=0;i<numVertices;++i )
+			remaining[i] = i;
+
+		int numRemaining = numVertices;
+		int current = 0;
+		int numFailed = 0; // number of vertices tested since the last ear was clipped
+		while( numRemaining > 3 )
+		{
+			int i0 = remaining[(current+numRemaining-1)%numRemaining];
+			int i1 = remaining[current];
+			int i2 = remaining[(current+1)%numRemaining];
+			const math::V2f &p0 = projected[i0];
+			const math::V2f &p1 = projected[i1];
+			const math::V2f &p2 = projected[i2];
+
+			bool isEar = orient2d( p0, p1, p2 ) > 0.0f;
+			for( int j=0;isEar && (j<numRemaining);++j )
+			{
+				int k = remaining[j];
+				if( (k == i0)||(k == i1)||(k == i2) )
+					continue;
+				const math::V2f &p = projected[k];
+				if( (orient2d( p0, p1, p ) >= 0.0f)&&(orient2d( p1, p2, p ) >= 0.0f)&&(orient2d( p2, p0, p ) >= 0.0f) )
+					isEar = false;
+			}
+
+			// degenerate polygons may have no ear left, in which case the current vertex is clipped anyway
+			if( isEar || (numFailed >= numRemaining) )
+			{
+				*out++ = vertices[i0];
+				*out++ = vertices[i1];
+				*out++ = vertices[i2];
+				remaining.erase( remaining.begin() + current );
+				--numRemaining;
+				if( current >= numRemaining )
+					current = 0;
+				numFailed = 0;
+			}else
+			{
+				current = (current+1)%numRemaining;
+				++numFailed;
+			}
+		}
+		*out++ = vertices[remaining[0]];
+		*out++ = vertices[remaining[1]];
+		*out++ = vertices[remaining[2]];
+	}
+
+	// triangulates polygons with arbitrary vertex counts into the index buffer of given triangle geometry
+	// the triangle offset of each polygon is taken from a prefix sum over the triangle counts, which allows
+	// polygons to be triangulated in parallel
+	static void triangulatePolys( Geometry::Ptr geo, HouGeo::HouPoly::Ptr poly, const std::vector<int> &vertexToPoint )
+	{
+		sint64 numPolys = poly->numPolys();
+		std::vector<sint64> vertexOffset( numPolys+1, 0 );
+		std::vector<sint64> triangleOffset( numPolys+1, 0 );
+		for( sint64 i=0;i<numPolys;++i )
+		{
+			int numVerts = poly->numVertices((int)i);
+			vertexOffset[i+1] = vertexOffset[i] + numVerts;
+			triangleOffset[i+1] = triangleOffset[i] + std::max( 0, numVerts-2 );
+		}
+
+		sint64 numTriangles = triangleOffset[numPolys];
+		size_t indexOffset = geo->m_indexBuffer.size();
+		geo->m_indexBuffer.resize( indexOffset + numTriangles*3 );
+		unsigned int *indices = geo->m_indexBuffer.data() + indexOffset;
+
+		Attribute::CPtr pAttr = geo->getAttr("P");
+		parallelFor( 0, numPolys, [&]( sint64 begin, sint64 end )
+		{
+			std::vector<math::V3f> positions;
+			std::vector<math::V2f> projected;
+			std::vector<int> remaining;
+			for( sint64 i=begin;i<end;++i )
+			{
+				int numVerts = int(vertexOffset[i+1] - vertexOffset[i]);
+				if( numVerts >= 3 )
+					triangulatePoly( &vertexToPoint[vertexOffset[i]], numVerts, pAttr, indices + triangleOffset[i]*3, positions, projected, remaining );
+			}
+		}, 1024 );
+
+		geo->m_numPrimitives += (unsigned int)numTriangles;
+		geo->m_indexBufferIsDirty = true;
+	}
+
 	// prim -1 means we will get a simple pointsgeometry
-	Geometry::Ptr HouGeoIO::convertToGeometry(HouGeo::Ptr houGeo, HouGeoAdapter::Primitive::Ptr houPrim )
+	Geometry::Ptr HouGeoIO::convertToGeometry(HouGeo::Ptr houGeo, HouGeoAdapter::Primitive::Ptr houPrim, bool triangulate )
 	{
 		Geometry::Ptr result;
 
@@ -103,8 +368,8 @@ namespace houio
 		sint64 numPoints = houGeo->pointcount();
 		sint64 numVertices = houGeo->vertexcount();
 
-		// we only support geometry with non mixed primitives (e.g. triangles only)
-		// this code checks if that is the case...
+		// geometry only supports non mixed primitives (e.g. triangles only)
+		// closed polygons with mixed or more than 4 vertices are triangulated
 		int numVerticesPerPoly = 0;
 		if( houPrim )
 		{
@@ -121,8 +386,11 @@ namespace houio
 						break;
 					}
 			}
-			if( !hasConstantVertexCountPerPoly )
-				throw std::runtime_error( "convertHouGeoPrimitive: non constant polygon primitvies" );
+			if( !hasConstantVertexCountPerPoly || (numVerticesPerPoly > 4) )
+				triangulate = true;
+			// open polygons are curves which can not be triangulated
+			if( triangulate && !poly->closed() )
+				throw std::runtime_error( "convertHouGeoPrimitive: open polygons with non constant vertex count" );
 		}
 
 		// create the right kind of geometry depending on vertexcount per primitive (point, line or triangle geometry)
@@ -131,6 +399,11 @@ namespace houio
 			result = Geometry::createPointGeometry();
 		}
 		else
+		if( triangulate )
+		{
+			result = Geometry::createTriangleGeometry();
+		}
+		else
 		if( numVerticesPerPoly == 2 )
 		{
 			result = Geometry::createLineGeometry();
@@ -162,39 +435,29 @@ namespace houio
 			HouGeoAdapter::AttributeAdapter::Ptr houAttr = houGeo->getPointAttribute(attrName);
 			int numComponents = houAttr->getTupleSize();
 
+			// geometry attributes are views into the houdini attributes, the data is only copied when modified
 			Attribute::Ptr attr;
 			if( attrName == "P" )
 			{
-				attr = result->getAttr("P");
-				float *ptr = (float*)houGeo->getPointAttribute( attrName )->getRawPointer()->ptr;
-				for( int i=0;i<numPoints;++i )
-				{
-					math::Vec3f p;
-					p.x = *ptr++; p.y = *ptr++; p.z = *ptr++;ptr++;
-					attr->appendElement( p );
-				}
+				// xyz of the (usually) 4 component houdini position
+				attr = Attribute::createView( floatAttribute( houAttr ), 3 );
 			}else
 			if( (attrName == "UV")||(attrName == "uv") )
 			{
-				float *ptr = (float*)houGeo->getPointAttribute( attrName )->getRawPointer()->ptr;
 				attrName = "UV";
-				attr = Attribute::createV2f();
-				for( int i=0;i<numPoints;++i )
-				{
-					math::Vec2f uv;
-					uv.x = *ptr++; uv.y = *ptr++;ptr++;
-					attr->appendElement( uv );
-				}
+				attr = Attribute::createView( floatAttribute( houAttr ), 2 );
 			}else
-			if( houAttr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32 )
-				attr = Attribute::create( numComponents, Attribute::FLOAT, (unsigned char *)houAttr->getRawPointer()->ptr, houAttr->getNumElements() );
-			else
-			if( houAttr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT32 )
 			{
-				attr = Attribute::create( numComponents, Attribute::INT, (unsigned char *)houAttr->getRawPointer()->ptr, houAttr->getNumElements() );
-
-			}else
-				std::cout << "HouGeoIO::convertToGeometry: warning: unable to handle storage type " << houAttr->getStorage() << " for attribute " << attrName << std::endl;
+				// attributes keep their native storage, use Attribute::convert if a specific type is needed
+				Attribute::Ptr src = sourceAttribute( houAttr );
+				if( src )
+					attr = Attribute::createView( src, numComponents );
+				else
+				{
+					std::cout << "HouGeoIO::convertToGeometry: warning: unable to handle storage type " << houAttr->getStorage() << " for attribute " << attrName << std::endl;
+					continue;
+				}
+			}
 
 			result->setAttr( attrName, attr );
 		}
@@ -208,28 +471,27 @@ namespace houio
 
 			int numComponents = houAttr->getTupleSize();
 
+			// vertex attributes are only read from, so we use views into the houdini attributes
 			Attribute::Ptr attr;
 			if( (attrName == "UV")||(attrName == "uv") )
 			{
-				float *ptr = (float*)houGeo->getVertexAttribute( attrName )->getRawPointer()->ptr;
 				attrName = "UV";
-				attr = Attribute::createV2f();
-
-				for( int i=0;i<numVertices;++i )
+				attr = Attribute::createView( floatAttribute( houAttr ), 2 );
+			}else
+			{
+				Attribute::Ptr src = sourceAttribute( houAttr );
+				if( !src )
 				{
-					math::Vec2f uv;
-					uv.x = *ptr++; uv.y = *ptr++;ptr++;
-					attr->appendElement( uv );
+					std::cout << "HouGeoIO::convertToGeometry: warning: unable to handle storage type " << houAttr->getStorage() << " for attribute " << attrName << std::endl;
+					continue;
 				}
-			}else
-			if( houAttr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32 )
-				attr = Attribute::create( numComponents, Attribute::FLOAT, (unsigned char *)houAttr->getRawPointer()->ptr, houAttr->getNumElements() );
+				attr = Attribute::createView( src, numComponents );
+			}
 
 
 			// create point attribute which we will derive from this vertex attribute
-			Attribute::Ptr pointAttr = attr->copy();
-			pointAttr->resize( (int)numPoints );
-			memset( pointAttr->getRawPointer(), 0, numPoints*pointAttr->elementComponentSize()*pointAttr->numComponents() );
+			// it is allocated once we know how many points have to be split
+			Attribute::Ptr pointAttr = std::make_shared<Attribute>( attr->numComponents(), attr->elementComponentType() );
 
 			result->setAttr( attrName, pointAttr );
 			vertex2pointAttr.push_back( std::make_pair( attr, pointAttr ) );
@@ -237,7 +499,15 @@ namespace houio
 
 
 		// only done when we have primitives...
-		if( houPrim )
+		if( !houPrim )
+		{
+			for( auto &it : vertex2pointAttr )
+			{
+				it.second->resize( (int)numPoints );
+				if( numPoints > 0 )
+					memset( it.second->getRawPointer(), 0, numPoints*it.second->elementSize() );
+			}
+		}else
 		{
 			HouGeo::HouPoly::Ptr poly = std::dynamic_pointer_cast<HouGeo::HouPoly>(houPrim);
 			sint64 numPolys = poly->numPolys();
@@ -248,103 +518,840 @@ namespace houio
 			// which have different vertex data
 			const int *vertex_ptr = poly->vertices();
 
-			std::vector<bool> pointsToSplit(numPoints, false);
-			std::vector<bool> pointsInitialized(numPoints, false);
+			// points are split per unique (point, vertex attribute values) key
+			// the first key of a point keeps the point index, every other key gets a new point
+			std::vector<int> vertexToPoint( numVertices );
+			std::vector<int> pointVertex( numPoints, -1 ); // vertex from which the values of a point are taken
+			std::vector<int> splitSource; // original point for each split point
+			if( vertex2pointAttr.empty() )
+			{
+				for( sint64 i=0;i<numVertices;++i )
+				{
+					vertexToPoint[i] = vertex_ptr[i];
+					pointVertex[vertex_ptr[i]] = (int)i;
+				}
+			}else
+			{
+				// hash vertex attribute values
+				std::vector<size_t> vertexHash( numVertices );
+				parallelFor( 0, numVertices, [&]( sint64 begin, sint64 end )
+				{
+					for( sint64 i=begin;i<end;++i )
+					{
+						// FNV-1a
+						size_t hash = 14695981039346656037ULL;
+						for( auto &it : vertex2pointAttr )
+						{
+							const unsigned char *bytes = (const unsigned char *)it.first->data( (int)i );
+							int size = it.first->elementSize();
+							for( int j=0;j<size;++j )
+								hash = (hash ^ bytes[j])*1099511628211ULL;
+						}
+						vertexHash[i] = hash ^ ((size_t)vertex_ptr[i]*0x9e3779b97f4a7c15ULL);
+					}
+				});
 
-			// mark all points which have to be duplicated
-			std::vector<int> firstVertex(numPoints, -1);
-			for( int i=0;i<numVertices;++i )
+				auto vertexKeyHash = [&]( int vertex ){ return vertexHash[vertex]; };
+				auto vertexKeyEqual = [&]( int v0, int v1 )
+				{
+					if( vertex_ptr[v0] != vertex_ptr[v1] )
+						return false;
+					for( auto &it : vertex2pointAttr )
+						if( memcmp( it.first->data(v0), it.first->data(v1), it.first->elementSize() ) )
+							return false;
+					return true;
+				};
+				std::unordered_map<int, int, decltype(vertexKeyHash), decltype(vertexKeyEqual)> keys( (size_t)numPoints, vertexKeyHash, vertexKeyEqual );
+
+				for( int i=0;i<numVertices;++i )
+				{
+					auto inserted = keys.insert( std::make_pair( i, -1 ) );
+					if( inserted.second )
+					{
+						int point = vertex_ptr[i];
+						if( pointVertex[point] < 0 )
+							inserted.first->second = point;
+						else
+						{
+							inserted.first->second = int(numPoints + splitSource.size());
+							splitSource.push_back( point );
+						}
+					}
+					int finalPointIndex = inserted.first->second;
+					vertexToPoint[i] = finalPointIndex;
+					if( finalPointIndex < numPoints )
+						pointVertex[finalPointIndex] = i;
+					else
+					if( (sint64)pointVertex.size() <= finalPointIndex )
+						pointVertex.push_back( i );
+				}
+			}
+
+			// point attributes derived from vertex attributes are allocated once
+			sint64 numSplits = splitSource.size();
+			sint64 numFinalPoints = numPoints + numSplits;
+			for( auto &it : vertex2pointAttr )
+				it.second->resize( (int)numFinalPoints );
+
+			// the other point attributes keep sharing the houdini data unless points have been split
+			if( numSplits > 0 )
 			{
-				int point = vertex_ptr[i];
-				if( !pointsToSplit[point] )
+				for( auto &it : result->m_attributes )
 				{
-					if( firstVertex[point] >=0 )
+					bool isVertexAttr = false;
+					for( auto &it2 : vertex2pointAttr )
+						isVertexAttr |= (it2.second == it.second);
+					if( isVertexAttr )
+						continue;
+
+					// copy point attributes to split points
+					Attribute::Ptr attr = it.second;
+					attr->resize( (int)numFinalPoints );
+					unsigned char *data = (unsigned char *)attr->getRawPointer();
+					int size = attr->elementSize();
+					parallelFor( 0, numSplits, [&]( sint64 begin, sint64 end )
 					{
-						// compare
-						for( std::vector<std::pair<Attribute::Ptr, Attribute::Ptr>>::iterator it = vertex2pointAttr.begin(), end = vertex2pointAttr.end(); it != end; ++it )
-							if( memcmp( it->first->getRawPointer(i), it->first->getRawPointer(firstVertex[point]), it->first->elementComponentSize()*it->first->numComponents() ) )
-							{
-								pointsToSplit[point] = true;
-								//result->getAttr("Cd")->set( point, 1.0f, 0.0f, 0.0f );
-								break;
-							}
-					}else
-						firstVertex[point] = i;
+						for( sint64 i=begin;i<end;++i )
+							memcpy( data + (numPoints+i)*size, data + splitSource[i]*size, size );
+					});
 				}
 			}
 
-			int vertexIndex = 0;
-			for( int i=0;i<numPolys;++i )
+			// scatter vertex attributes to their points
+			for( auto &it : vertex2pointAttr )
 			{
-				int numVerts = poly->numVertices(i);
-				std::vector<int> vertices;
-				vertices.reserve(4);
+				Attribute::Ptr vertexAttr = it.first;
+				unsigned char *data = (unsigned char *)it.second->getRawPointer();
+				int size = it.second->elementSize();
+				parallelFor( 0, numFinalPoints, [&]( sint64 begin, sint64 end )
+				{
+					for( sint64 i=begin;i<end;++i )
+						if( pointVertex[i] >= 0 )
+							memcpy( data + i*size, vertexAttr->data(pointVertex[i]), size );
+						else
+							memset( data + i*size, 0, size );
+				});
+			}
 
-				for( int j=0;j<numVerts;++j, ++vertexIndex )
+			if( triangulate )
+				triangulatePolys( result, poly, vertexToPoint );
+			else
+			{
+				result->m_indexBuffer.reserve( result->m_indexBuffer.size() + numVertices );
+				int vertexIndex = 0;
+				for( int i=0;i<numPolys;++i )
 				{
-					unsigned int finalPointIndex = vertex_ptr[j];
+					int numVerts = poly->numVertices(i);
+					const int *vertices = &vertexToPoint[vertexIndex];
+
+					if( numVerts == 2 )
+						result->addLine( vertices[0], vertices[1] );
+					else
+					if( numVerts == 3 )
+						result->addTriangle( vertices[0], vertices[1], vertices[2] );
+					else
+					if( numVerts == 4 )
+						result->addQuad( vertices[0], vertices[1], vertices[2], vertices[3] );
+
+					vertexIndex+=numVerts;
+				}
+			}
 
-					if( pointsToSplit[finalPointIndex] && pointsInitialized[finalPointIndex] )
+			// houdini polys are CW - opengl defaults to CCW
+			result->reverse();
+		}
+		return result;
+	}
+
+	void HouGeoIO::makeLog( const std::string &path, std::ostream *out )
+	{
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+		json::JSONLogger logger(*out);
+		json::Parser p;
+		p.parse( &in, &logger );
+	}
+
+	namespace
+	{
+		enum ProbeFrameType
+		{
+			FRAME_OTHER,
+			FRAME_ROOT,
+			FRAME_ATTRIBUTES,
+			FRAME_ATTRIBUTE_LIST,
+			FRAME_ATTRIBUTE,
+			FRAME_ATTRIBUTE_DEFINITION,
+			FRAME_ATTRIBUTE_DATA,
+			FRAME_PRIMITIVES,
+			FRAME_PRIMITIVE,
+			FRAME_PRIMITIVE_DEFINITION,
+			FRAME_PRIMITIVE_DATA,
+			FRAME_RESOLUTION,
+			FRAME_GROUP_LIST,
+			FRAME_GROUP,
+			FRAME_GROUP_DEFINITION,
+			FRAME_TOPOLOGY,
+			FRAME_POINTREF,
+			FRAME_ATTRIBUTE_VALUES,
+			FRAME_VOXELS,
+			FRAME_TILED_ARRAY,
+			FRAME_TILES,
+			FRAME_TILE
+		};
+
+		// array or map which is currently being parsed
+		struct ProbeFrame : public json::KeyValueFrame
+		{
+			ProbeFrameType                                type;
+			sint64                                        entry; // index entry which is recorded for this frame or -1
+		};
+
+		// json handler which collects the metadata of a bgeo file
+		// uniform arrays (which hold all the bulk data) are skipped by seeking over them
+		struct ProbeHandler : public json::KeyValueHandler<ProbeFrame>
+		{
+			ProbeHandler( HouGeoIO::Metadata &metadata, HouGeoIndex *index, std::istream *stream ) :
+				m_metadata(metadata),
+				m_index(index),
+				m_stream(stream),
+				m_attributeList(0),
+				m_groupList(0),
+				m_numPrimitives(0)
+			{
+			}
+
+			// starts an index entry for the container which has just been opened
+			void beginEntry( ProbeFrame &frame, HouGeoIndex::EntryType type, const std::string &name = "" )
+			{
+				if( !m_index )
+					return;
+				HouGeoIndex::Entry entry;
+				entry.type = type;
+				entry.name = name;
+				entry.primitive = -1;
+				entry.tile = -1;
+				// the begin token is the last byte read
+				entry.offset = sint64(m_stream->tellg()) - 1;
+				entry.size = 0;
+				entry.dataOffset = -1;
+				entry.dataSize = 0;
+				entry.numStringDefinitions = sint64(m_index->stringDefinitions.size());
+				frame.entry = sint64(m_index->entries.size());
+				m_index->entries.push_back( entry );
+			}
+
+			HouGeoIndex::Entry *frameEntry( const ProbeFrame &frame )
+			{
+				return (m_index && (frame.entry >= 0)) ? &m_index->entries[frame.entry] : 0;
+			}
+
+			virtual void beginFrame( ProbeFrame &frame, const ProbeFrame *parent, const std::string &key )override
+			{
+				frame.type = FRAME_OTHER;
+				frame.entry = -1;
+				if( !parent )
+				{
+					frame.type = FRAME_ROOT;
+					return;
+				}
+
+				switch( parent->type )
+				{
+				case FRAME_ROOT:
+					if( key == "attributes" )
+						frame.type = FRAME_ATTRIBUTES;
+					else
+					if( key == "topology" )
 					{
-						finalPointIndex = result->duplicatePoint(finalPointIndex);
-						// copy vertex attributes to duplicated point location
-						for( std::vector<std::pair<Attribute::Ptr, Attribute::Ptr>>::iterator it = vertex2pointAttr.begin(), end = vertex2pointAttr.end(); it != end; ++it )
-							memcpy( it->second->getRawPointer(finalPointIndex), it->first->getRawPointer(vertexIndex), it->first->elementComponentSize()*it->first->numComponents());
+						frame.type = FRAME_TOPOLOGY;
+						beginEntry( frame, HouGeoIndex::ENTRY_TOPOLOGY );
 					}
-					else if( !pointsInitialized[finalPointIndex]  )
+					else
+					if( key == "primitives" )
+						frame.type = FRAME_PRIMITIVES;
+					else
+					if( (key == "pointgroups")||(key == "primitivegroups") )
 					{
-						pointsInitialized[finalPointIndex] = true;
-						// copy vertex attributes to duplicated point location
-						for( std::vector<std::pair<Attribute::Ptr, Attribute::Ptr>>::iterator it = vertex2pointAttr.begin(), end = vertex2pointAttr.end(); it != end; ++it )
-							memcpy( it->second->getRawPointer(finalPointIndex), it->first->getRawPointer(vertexIndex), it->first->elementComponentSize()*it->first->numComponents());
+						frame.type = FRAME_GROUP_LIST;
+						m_groupList = key == "pointgroups" ? &m_metadata.pointGroups : &m_metadata.primitiveGroups;
+						m_groupEntryType = key == "pointgroups" ? HouGeoIndex::ENTRY_POINT_GROUP : HouGeoIndex::ENTRY_PRIMITIVE_GROUP;
 					}
+					break;
+				case FRAME_ATTRIBUTES:
+					m_attributeList = 0;
+					if( key == "pointattributes" )
+					{
+						m_attributeList = &m_metadata.pointAttributes;
+						m_attributeEntryType = HouGeoIndex::ENTRY_POINT_ATTRIBUTE;
+					}else
+					if( key == "vertexattributes" )
+					{
+						m_attributeList = &m_metadata.vertexAttributes;
+						m_attributeEntryType = HouGeoIndex::ENTRY_VERTEX_ATTRIBUTE;
+					}else
+					if( key == "primitiveattributes" )
+					{
+						m_attributeList = &m_metadata.primitiveAttributes;
+						m_attributeEntryType = HouGeoIndex::ENTRY_PRIMITIVE_ATTRIBUTE;
+					}else
+					if( key == "globalattributes" )
+					{
+						m_attributeList = &m_metadata.globalAttributes;
+						m_attributeEntryType = HouGeoIndex::ENTRY_GLOBAL_ATTRIBUTE;
+					}
+					if( m_attributeList )
+						frame.type = FRAME_ATTRIBUTE_LIST;
+					break;
+				case FRAME_ATTRIBUTE_LIST:
+					frame.type = FRAME_ATTRIBUTE;
+					m_attr = HouGeoIO::Metadata::AttributeInfo();
+					m_attr.tupleSize = 1;
+					beginEntry( frame, m_attributeEntryType );
+					break;
+				case FRAME_ATTRIBUTE:
+					if( parent->index == 0 )
+						frame.type = FRAME_ATTRIBUTE_DEFINITION;
+					else
+					if( parent->index == 1 )
+						frame.type = FRAME_ATTRIBUTE_DATA;
+					break;
+				case FRAME_ATTRIBUTE_DATA:
+					if( key == "values" )
+						frame.type = FRAME_ATTRIBUTE_VALUES;
+					break;
+				case FRAME_TOPOLOGY:
+					if( key == "pointref" )
+						frame.type = FRAME_POINTREF;
+					break;
+				case FRAME_PRIMITIVES:
+					frame.type = FRAME_PRIMITIVE;
+					m_primitiveType = "";
+					m_runType = "";
+					m_runCount = 1;
+					m_numTiles = 0;
+					beginEntry( frame, HouGeoIndex::ENTRY_PRIMITIVE );
+					if( HouGeoIndex::Entry *entry = frameEntry(frame) )
+						entry->primitive = m_numPrimitives;
+					break;
+				case FRAME_PRIMITIVE:
+					if( parent->index == 0 )
+						frame.type = FRAME_PRIMITIVE_DEFINITION;
+					else
+					if( parent->index == 1 )
+						frame.type = FRAME_PRIMITIVE_DATA;
+					break;
+				case FRAME_PRIMITIVE_DATA:
+					if( (key == "res")&&(m_primitiveType == "Volume") )
+					{
+						frame.type = FRAME_RESOLUTION;
+						m_metadata.volumeResolutions.push_back( math::V3i(0) );
+					}else
+					if( key == "voxels" )
+						frame.type = FRAME_VOXELS;
+					break;
+				case FRAME_VOXELS:
+					if( parent->index == 1 )
+						frame.type = FRAME_TILED_ARRAY;
+					break;
+				case FRAME_TILED_ARRAY:
+					if( key == "tiles" )
+						frame.type = FRAME_TILES;
+					break;
+				case FRAME_TILES:
+					frame.type = FRAME_TILE;
+					beginEntry( frame, HouGeoIndex::ENTRY_VOLUME_TILE, "Volume" );
+					if( HouGeoIndex::Entry *entry = frameEntry(frame) )
+					{
+						entry->primitive = m_numPrimitives;
+						entry->tile = m_numTiles;
+					}
+					++m_numTiles;
+					break;
+				case FRAME_GROUP_LIST:
+					frame.type = FRAME_GROUP;
+					beginEntry( frame, m_groupEntryType );
+					break;
+				case FRAME_GROUP:
+					if( parent->index == 0 )
+						frame.type = FRAME_GROUP_DEFINITION;
+					break;
+				default:
+					break;
+				};
+			}
 
-					//if( vertex2pointAttr[0].first->get<math::Vec2f>(vertexIndex).x == result->getAttr("UV")->get<math::Vec2f>(finalPointIndex).x )
-					//	result->getAttr("Cd")->set(finalPointIndex, 1.0f, 0.0f, 0.0f);
+			virtual void endFrame( const ProbeFrame &frame )override
+			{
+				if( HouGeoIndex::Entry *entry = frameEntry(frame) )
+					entry->size = sint64(m_stream->tellg()) - entry->offset;
+
+				if( frame.type == FRAME_ATTRIBUTE )
+				{
+					m_attributeList->push_back( m_attr );
+					if( HouGeoIndex::Entry *entry = frameEntry(frame) )
+						entry->name = m_attr.name;
+				}else
+				if( (frame.type == FRAME_PRIMITIVE_DATA)&&(m_primitiveType == "run") )
+					// each element of a run is one primitive
+					m_runCount = frame.index;
+				else
+				if( frame.type == FRAME_PRIMITIVE )
+				{
+					// compact polygon runs are counted as the polygons they contain
+					bool isRun = (m_primitiveType == "run")||(m_primitiveType == "Polygon_run");
+					std::string type = m_primitiveType == "run" ? m_runType : m_primitiveType == "Polygon_run" ? "Poly" : m_primitiveType;
+					m_metadata.primitiveTypes[type] += isRun ? m_runCount : 1;
+					if( HouGeoIndex::Entry *entry = frameEntry(frame) )
+						entry->name = type;
+					++m_numPrimitives;
+				}
+			}
 
-					vertices.push_back(finalPointIndex);
+			virtual void value( ProbeFrame &frame, const std::string *string, sint64 intValue, bool )override
+			{
+				if( frame.type == FRAME_RESOLUTION )
+				{
+					if( frame.index < 3 )
+						m_metadata.volumeResolutions.back()[int(frame.index)] = int(intValue);
+				}else
+				if( frame.isValue() )
+				{
+					const std::string &key = frame.key;
+					switch( frame.type )
+					{
+					case FRAME_ROOT:
+						if( key == "pointcount" )
+							m_metadata.pointCount = intValue;
+						else
+						if( key == "vertexcount" )
+							m_metadata.vertexCount = intValue;
+						else
+						if( key == "primitivecount" )
+							m_metadata.primitiveCount = intValue;
+						break;
+					case FRAME_ATTRIBUTE_DEFINITION:
+						if( string && (key == "name") )
+							m_attr.name = *string;
+						else
+						if( string && (key == "type") )
+							m_attr.type = *string;
+						break;
+					case FRAME_ATTRIBUTE_DATA:
+						if( string && (key == "storage") )
+							m_attr.storage = *string;
+						else
+						if( key == "size" )
+							m_attr.tupleSize = int(intValue);
+						break;
+					case FRAME_PRIMITIVE_DEFINITION:
+						if( string && (key == "type") )
+							m_primitiveType = *string;
+						else
+						if( string && (key == "runtype") )
+							m_runType = *string;
+						break;
+					case FRAME_PRIMITIVE_DATA:
+						if( (key == "nprimitives")&&(m_primitiveType == "Polygon_run") )
+							m_runCount = intValue;
+						break;
+					case FRAME_GROUP_DEFINITION:
+						if( string && (key == "name") )
+						{
+							m_groupList->push_back( *string );
+							if( HouGeoIndex::Entry *entry = frameEntry( m_frames[m_frames.size()-2] ) )
+								entry->name = *string;
+						}
+						break;
+					default:
+						break;
+					};
 				}
+			}
 
-				if( numVerts == 2 )
-					result->addLine( vertices[0], vertices[1] );
+			// records the payload of uniform arrays which hold the bulk data of index entries
+			void recordPayload( sint64 numBytes )
+			{
+				if( !m_index || m_frames.empty() || !m_frames.back().isValue() )
+					return;
+				const ProbeFrame &frame = m_frames.back();
+				if( frame.entry < 0 && m_frames.size() < 2 )
+					return;
+
+				HouGeoIndex::Entry *entry = 0;
+				if( (frame.type == FRAME_ATTRIBUTE_VALUES)&&(frame.key == "rawpagedata") )
+					// values frame lives in attribute data which lives in the attribute
+					entry = frameEntry( m_frames[m_frames.size()-3] );
 				else
-				if( numVerts == 3 )
-					result->addTriangle( vertices[0], vertices[1], vertices[2] );
+				if( (frame.type == FRAME_POINTREF)&&(frame.key == "indices") )
+					entry = frameEntry( m_frames[m_frames.size()-2] );
 				else
-				if( numVerts == 4 )
-					result->addQuad( vertices[0], vertices[1], vertices[2], vertices[3] );
+				if( (frame.type == FRAME_TILE)&&(frame.key == "data") )
+					entry = frameEntry( frame );
 
-				vertex_ptr+=numVerts;
+				if( entry )
+				{
+					entry->dataOffset = sint64(m_stream->tellg());
+					entry->dataSize = numBytes;
+				}
 			}
 
-			// houdini polys are CW - opengl defaults to CCW
-			result->reverse();
-		}
-		return result;
+			template<typename T>
+			void uniformArray( sint64 numElements, json::Parser *parser )
+			{
+				recordPayload( numElements*sizeof(T) );
+				// volume resolution is the only uniform array we are interested in
+				const ProbeFrame *frame = m_frames.empty() ? 0 : &m_frames.back();
+				if( frame && (frame->type == FRAME_PRIMITIVE_DATA) && frame->isValue() && (frame->key == "res") && (m_primitiveType == "Volume") && (numElements == 3) )
+				{
+					math::V3i res;
+					for( int i=0;i<3;++i )
+						res[i] = int(parser->read<T>());
+					m_metadata.volumeResolutions.push_back( res );
+				}else
+					parser->stream->seekg( numElements*sizeof(T), std::ios_base::cur );
+				nextElement();
+			}
+
+			virtual void uaBool( sint64 numElements, json::Parser *parser )override
+			{
+				// bool uniform arrays are bitstreams (32 bits per word)
+				recordPayload( ((numElements+31)/32)*sizeof(uint32) );
+				parser->stream->seekg( ((numElements+31)/32)*sizeof(uint32), std::ios_base::cur );
+				nextElement();
+			}
+			virtual void uaReal16( sint64 numElements, json::Parser *parser )override{uniformArray<real16>( numElements, parser );}
+			virtual void uaReal32( sint64 numElements, json::Parser *parser )override{uniformArray<real32>( numElements, parser );}
+			virtual void uaReal64( sint64 numElements, json::Parser *parser )override{uniformArray<real64>( numElements, parser );}
+			virtual void uaInt8( sint64 numElements, json::Parser *parser )override{uniformArray<sbyte>( numElements, parser );}
+			virtual void uaInt16( sint64 numElements, json::Parser *parser )override{uniformArray<sword>( numElements, parser );}
+			virtual void uaInt32( sint64 numElements, json::Parser *parser )override{uniformArray<sint32>( numElements, parser );}
+			virtual void uaInt64( sint64 numElements, json::Parser *parser )override{uniformArray<sint64>( numElements, parser );}
+			virtual void uaUInt8( sint64 numElements, json::Parser *parser )override{uniformArray<ubyte>( numElements, parser );}
+			virtual void uaUInt16( sint64 numElements, json::Parser *parser )override{uniformArray<uword>( numElements, parser );}
+			virtual void uaString( sint64 numElements, json::Parser *parser )override
+			{
+				// strings have variable length and need to be read
+				for( sint64 i=0;i<numElements;++i )
+					parser->readBinaryString();
+				nextElement();
+			}
+
+			virtual void stringDefinition( sint64 id, const std::string &value )override
+			{
+				if( m_index )
+					m_index->stringDefinitions.push_back( std::make_pair( id, value ) );
+			}
+
+			HouGeoIO::Metadata                               &m_metadata;
+			HouGeoIndex                                      *m_index;
+			std::istream                                     *m_stream;
+			HouGeoIndex::EntryType                            m_attributeEntryType;
+			HouGeoIndex::EntryType                            m_groupEntryType;
+			std::vector<HouGeoIO::Metadata::AttributeInfo>   *m_attributeList;
+			std::vector<std::string>                         *m_groupList;
+			HouGeoIO::Metadata::AttributeInfo                 m_attr;
+			std::string                                       m_primitiveType;
+			std::string                                       m_runType;
+			sint64                                            m_runCount;
+			sint64                                            m_numPrimitives;
+			sint64                                            m_numTiles;
+		};
 	}
 
-	void HouGeoIO::makeLog( const std::string &path, std::ostream *out )
+	HouGeoIO::Metadata::Metadata() :
+		valid(false),
+		pointCount(0),
+		vertexCount(0),
+		primitiveCount(0)
+	{
+	}
+
+	HouGeoIO::Metadata HouGeoIO::probe( const std::string &path, HouGeoIndex::Ptr index )
 	{
+		Metadata metadata;
 		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
-		json::JSONLogger logger(*out);
+		ProbeHandler handler( metadata, index.get(), &in );
 		json::Parser p;
-		p.parse( &in, &logger );
+		metadata.valid = p.parse( &in, &handler );
+		if( !metadata.valid )
+			std::cout << "HouGeoIO::probe: failed to parse " << path << std::endl;
+		if( index )
+		{
+			index->pointCount = metadata.pointCount;
+			index->vertexCount = metadata.vertexCount;
+			index->primitiveCount = metadata.primitiveCount;
+		}
+		return metadata;
 	}
 
+	namespace
+	{
+		// cheap non cryptographic hash for detecting changes between frames
+		uint64 hashBytes( const char *data, sint64 size, uint64 hash )
+		{
+			const uint64 prime = 0x9e3779b97f4a7c15ull;
+			sint64 numWords = size/8;
+			for( sint64 i=0;i<numWords;++i )
+			{
+				uint64 word;
+				memcpy( &word, data + i*8, 8 );
+				hash = (hash ^ word)*prime;
+				hash ^= hash >> 32;
+			}
+			for( sint64 i=numWords*8;i<size;++i )
+				hash = (hash ^ ubyte(data[i]))*prime;
+			return hash;
+		}
+
+		// attribute of the next frame which shares the data of the given attribute until either one is written to
+		HouGeo::HouAttribute::Ptr shareAttribute( HouGeo::HouAttribute::Ptr attr )
+		{
+			if( !attr )
+				return attr;
+			HouGeo::HouAttribute::Ptr result = std::make_shared<HouGeo::HouAttribute>( *attr );
+			if( attr->m_attr )
+				result->m_attr = Attribute::createView( attr->m_attr, char(attr->m_attr->numComponents()) );
+			return result;
+		}
 
+		std::string entryKey( const HouGeoIndex::Entry &entry )
+		{
+			switch( entry.type )
+			{
+			case HouGeoIndex::ENTRY_TOPOLOGY:return "topology";
+			case HouGeoIndex::ENTRY_POINT_ATTRIBUTE:return "pointattribute:" + entry.name;
+			case HouGeoIndex::ENTRY_VERTEX_ATTRIBUTE:return "vertexattribute:" + entry.name;
+			case HouGeoIndex::ENTRY_PRIMITIVE_ATTRIBUTE:return "primitiveattribute:" + entry.name;
+			case HouGeoIndex::ENTRY_GLOBAL_ATTRIBUTE:return "globalattribute:" + entry.name;
+			case HouGeoIndex::ENTRY_POINT_GROUP:return "pointgroup:" + entry.name;
+			case HouGeoIndex::ENTRY_PRIMITIVE_GROUP:return "primitivegroup:" + entry.name;
+			case HouGeoIndex::ENTRY_PRIMITIVE:
+				{
+					std::ostringstream key;
+					key << "primitive:" << entry.primitive;
+					return key.str();
+				}
+			default:
+				return "";
+			};
+		}
+	}
+
+	HouGeoIO::SequenceFrame::SequenceFrame() :
+		numShared(0),
+		numDecoded(0)
+	{
+	}
+
+	// the file is probed for the byte ranges of its entries, each entry is read once and compared against the reference frame
+	// only entries which differ (typically P, N, v) are parsed (from the bytes which have been read), the others are taken from the reference
+	HouGeoIO::SequenceFrame::Ptr HouGeoIO::importFrame( const std::string &path, SequenceFrame::Ptr reference )
+	{
+		SequenceFrame::Ptr frame = std::make_shared<SequenceFrame>();
+		HouGeoIndex::Ptr index = HouGeoIndex::create();
+		if( !probe( path, index ).valid )
+			return frame;
+
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+
+		// volumes and other primitives arent supported, the frame is imported as a whole
+		for( auto &entry:index->entries )
+			if( (entry.type == HouGeoIndex::ENTRY_VOLUME_TILE)||((entry.type == HouGeoIndex::ENTRY_PRIMITIVE)&&(entry.name != "Poly")) )
+			{
+				frame->houGeo = import( &in );
+				return frame;
+			}
+
+		// entries which depend on different string tables must not match
+		std::vector<uint64> stringHashes( 1, 0xcbf29ce484222325ull );
+		for( auto &definition:index->stringDefinitions )
+		{
+			uint64 hash = hashBytes( (const char *)&definition.first, sizeof(sint64), stringHashes.back() );
+			stringHashes.push_back( hashBytes( definition.second.c_str(), sint64(definition.second.size()), hash ) );
+		}
+
+		HouGeo::Ptr houGeo = HouGeo::create();
+		HouGeo::Ptr referenceGeo = reference ? reference->houGeo : HouGeo::Ptr();
+		std::vector<HouGeoAdapter::Primitive::Ptr> referencePrimitives;
+		if( referenceGeo )
+			referenceGeo->getPrimitives( referencePrimitives );
+		HouGeo::SharedPrimitiveData sharedPrimitiveData;
+		std::vector<char> buffer;
+		uint64 topologyHash = 0;
+		bool topologyHashed = true;
+
+		// entries are in file order, so the topology is there before the primitives which reference it
+		for( auto &entry:index->entries )
+		{
+			std::string key = entryKey( entry );
+
+			sint64 elementCount = 0;
+			switch( entry.type )
+			{
+			case HouGeoIndex::ENTRY_POINT_ATTRIBUTE:
+			case HouGeoIndex::ENTRY_POINT_GROUP:elementCount = index->pointCount;break;
+			case HouGeoIndex::ENTRY_VERTEX_ATTRIBUTE:elementCount = index->vertexCount;break;
+			case HouGeoIndex::ENTRY_PRIMITIVE_ATTRIBUTE:
+			case HouGeoIndex::ENTRY_PRIMITIVE_GROUP:elementCount = index->primitiveCount;break;
+			case HouGeoIndex::ENTRY_GLOBAL_ATTRIBUTE:elementCount = 1;break;
+			default:break;
+			};
+
+			buffer.resize( size_t(entry.size) );
+			in.clear();
+			in.seekg( entry.offset );
+			if( !in.read( buffer.data(), entry.size ) )
+				throw std::runtime_error( "HouGeoIO::importFrame: unable to read " + key + " from " + path );
+
+			// signature of the entry: its size and a hash of the span which holds its data
+			// (pointref indices of the topology, rawpagedata of attributes or the whole entry if it has no such payload)
+			// entries whose size differs from the reference have changed, they are not hashed and get no signature (the next frame hashes them)
+			// polys hold point indices which have been resolved through the topology, so they are only hashed along with it
+			const std::pair<sint64, uint64> *referenceSignature = 0;
+			if( reference )
+			{
+				auto it = reference->signatures.find( key );
+				if( it != reference->signatures.end() )
+					referenceSignature = &it->second;
+			}
+			bool hashed = !referenceSignature || (referenceSignature->first == entry.size);
+			if( entry.type == HouGeoIndex::ENTRY_PRIMITIVE )
+				hashed = hashed && topologyHashed;
+			std::pair<sint64, uint64> signature( entry.size, 0 );
+			if( hashed )
+			{
+				sint64 spanOffset = entry.dataOffset >= 0 ? entry.dataOffset - entry.offset : 0;
+				sint64 spanSize = entry.dataOffset >= 0 ? entry.dataSize : entry.size;
+				uint64 hash = stringHashes[std::min<sint64>( entry.numStringDefinitions, sint64(stringHashes.size())-1 )];
+				hash = hashBytes( (const char *)&elementCount, sizeof(sint64), hash );
+				hash = hashBytes( buffer.data() + spanOffset, spanSize, hash );
+				if( entry.type == HouGeoIndex::ENTRY_PRIMITIVE )
+					hash = hashBytes( (const char *)&topologyHash, sizeof(uint64), hash );
+				signature.second = hash;
+				frame->signatures[key] = signature;
+			}
+			if( entry.type == HouGeoIndex::ENTRY_TOPOLOGY )
+			{
+				topologyHashed = hashed;
+				topologyHash = signature.second;
+			}
+
+			// try to share with reference
+			// attribute data is shared copy on write, topology, polygons and groups are shared by pointer
+			bool shared = false;
+			if( referenceGeo && hashed && referenceSignature && (*referenceSignature == signature) )
+			{
+				HouGeo::HouAttribute::Ptr attr;
+				switch( entry.type )
+				{
+				case HouGeoIndex::ENTRY_TOPOLOGY:
+					if( HouGeo::HouTopology::Ptr topology = std::dynamic_pointer_cast<HouGeo::HouTopology>(referenceGeo->getTopology()) )
+					{
+						houGeo->setTopology( topology );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_POINT_ATTRIBUTE:
+					if( (attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>(referenceGeo->getPointAttribute(entry.name))) )
+					{
+						houGeo->setPointAttribute( shareAttribute( attr ) );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_VERTEX_ATTRIBUTE:
+					if( (attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>(referenceGeo->getVertexAttribute(entry.name))) )
+					{
+						houGeo->setVertexAttribute( shareAttribute( attr ) );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_PRIMITIVE_ATTRIBUTE:
+					if( (attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>(referenceGeo->getPrimitiveAttribute(entry.name))) )
+					{
+						houGeo->setPrimitiveAttribute( entry.name, shareAttribute( attr ) );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_GLOBAL_ATTRIBUTE:
+					if( (attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>(referenceGeo->getGlobalAttribute(entry.name))) )
+					{
+						houGeo->setGlobalAttribute( shareAttribute( attr ) );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_POINT_GROUP:
+					if( BitSet::Ptr group = referenceGeo->getPointGroup(entry.name) )
+					{
+						houGeo->setPointGroup( entry.name, group );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_PRIMITIVE_GROUP:
+					if( BitSet::Ptr group = referenceGeo->getPrimitiveGroup(entry.name) )
+					{
+						houGeo->setPrimitiveGroup( entry.name, group );
+						shared = true;
+					}break;
+				case HouGeoIndex::ENTRY_PRIMITIVE:
+					if( entry.primitive < sint64(referencePrimitives.size()) )
+						if( HouGeo::HouPoly::Ptr poly = std::dynamic_pointer_cast<HouGeo::HouPoly>(referencePrimitives[entry.primitive]) )
+						{
+							houGeo->addPrimitive( poly );
+							shared = true;
+						}
+					break;
+				default:
+					break;
+				};
+			}
+
+			if( shared )
+			{
+				++frame->numShared;
+				continue;
+			}
+
+			// decode from the bytes which have been read already
+			json::ArrayPtr root = index->parseEntry( buffer.data(), entry ).asArray();
+			std::string name;
+			switch( entry.type )
+			{
+			case HouGeoIndex::ENTRY_TOPOLOGY:houGeo->loadTopology( HouGeo::toObject(root) );break;
+			case HouGeoIndex::ENTRY_POINT_ATTRIBUTE:houGeo->setPointAttribute( HouGeo::loadAttribute( root, elementCount ) );break;
+			case HouGeoIndex::ENTRY_VERTEX_ATTRIBUTE:houGeo->setVertexAttribute( HouGeo::loadAttribute( root, elementCount ) );break;
+			case HouGeoIndex::ENTRY_PRIMITIVE_ATTRIBUTE:houGeo->setPrimitiveAttribute( entry.name, HouGeo::loadAttribute( root, elementCount ) );break;
+			case HouGeoIndex::ENTRY_GLOBAL_ATTRIBUTE:houGeo->setGlobalAttribute( HouGeo::loadAttribute( root, elementCount ) );break;
+			case HouGeoIndex::ENTRY_POINT_GROUP:houGeo->setPointGroup( entry.name, HouGeo::loadGroup( root, elementCount, name ) );break;
+			case HouGeoIndex::ENTRY_PRIMITIVE_GROUP:houGeo->setPrimitiveGroup( entry.name, HouGeo::loadGroup( root, elementCount, name ) );break;
+			case HouGeoIndex::ENTRY_PRIMITIVE:houGeo->loadPrimitive( root, sharedPrimitiveData, entry.primitive );break;
+			default:
+				break;
+			};
+			++frame->numDecoded;
+		}
+
+		frame->houGeo = houGeo;
+		return frame;
+	}
+
+
+
+	HouGeoIO::ExportOptions::ExportOptions() :
+		constantTiles(true),
+		tolerance(0.0f),
+		halfPrecisionTiles(false),
+		constantPages(false),
+		splitPacking(false),
+		binary(true),
+		internStrings(false),
+		polygonRuns(false)
+	{
+	}
 
 	// convinience funcion for quickly saving volume to bgeo
-	bool HouGeoIO::xport( const std::string& filename, ScalarField::Ptr volume )
+	bool HouGeoIO::xport( const std::string& filename, ScalarField::Ptr volume, const ExportOptions &options )
 	{
-		std::ofstream out( filename.c_str(), std::ios_base::out | std::ios_base::binary );
 		HouGeo::Ptr houGeo = std::make_shared<HouGeo>();
 		houGeo->addPrimitive(volume);
-		return HouGeoIO::xport( &out, houGeo );
+		return HouGeoIO::xport( filename, houGeo, false, options );
 	}
 
-	bool HouGeoIO::xport(const std::string &filename, Geometry::Ptr geo)
+	bool HouGeoIO::xport(const std::string &filename, Geometry::Ptr geo, const ExportOptions &options)
 	{
-		std::ofstream out( filename.c_str(), std::ios_base::out | std::ios_base::binary );
 		HouGeo::Ptr houGeo = std::make_shared<HouGeo>();
 
 
@@ -360,10 +1367,11 @@ namespace houio
 			{
 				// promote P attribute from v3f to v4f
 				Attribute::Ptr attr_new = std::make_shared<Attribute>( 4, Attribute::FLOAT);
-				int numElements = attr->numElements();
+				const Attribute &source = *attr;
+				int numElements = source.numElements();
 				for( int i=0;i<numElements;++i )
 				{
-					math::V3f p = attr->get<math::V3f>(i);
+					math::V3f p = source.get<math::V3f>(i);
 					attr_new->appendElement<math::V4f>( math::V4f(p.x, p.y, p.z, 1.0) );
 				}
 				attr = attr_new;
@@ -418,6 +1426,7 @@ namespace houio
 				poly->m_vertices.resize(geo->m_indexBuffer.size());
 				for( int i=0,count=geo->m_indexBuffer.size();i<count;++i )
 					poly->m_vertices[i] = i;
+				poly->m_startVertex = 0;
 
 				poly->m_closed = false;
 				if(geo->primitiveType() != Geometry::LINE)
@@ -428,7 +1437,17 @@ namespace houio
 		}
 
 
-		return HouGeoIO::xport( &out, houGeo );
+		return HouGeoIO::xport( filename, houGeo, false, options );
+	}
+
+	// the file is written without going through iostreams
+	bool HouGeoIO::xport( const std::string& filename, HouGeoAdapter::Ptr geo, bool useMmap, const ExportOptions &options )
+	{
+		json::FileSink sink( filename, 4 << 20, useMmap );
+		if( !sink.isOpen() )
+			return false;
+		bool result = HouGeoIO::xport( &sink, geo, options );
+		return sink.close() && result;
 	}
 
 	bool HouGeoIO::xport( const std::string& filename, const std::vector<math::V3f>& points )
@@ -438,492 +1457,45 @@ namespace houio
 		return xport(filename, pattr_v3f);
 	}
 
+	// point data is written straight from the given vectors without intermediate copies
 	bool HouGeoIO::xport( const std::string& filename, const std::map<std::string, std::vector<math::V3f>>& pattr_v3f )
 	{
-		Geometry::Ptr geo = Geometry::createPointGeometry();
-
+		sint64 numPoints = pattr_v3f.empty() ? 0 : sint64(pattr_v3f.begin()->second.size());
 		for( auto&it:pattr_v3f )
-		{
-			std::string name = it.first;
-			const std::vector<math::V3f>& data = it.second;
-
-			int numElements = int(data.size());
-			if (numElements > 0)
-			{
-				Attribute::Ptr attr = Attribute::createV3f(numElements);
-				memcpy(attr->getRawPointer(), &data[0], sizeof(math::V3f)*numElements);
-				geo->setAttr(name, attr);
-			}
-		}
-
-		return xport( filename, geo );
-	}
-
-
-
-
-	bool HouGeoIO::xport( std::ostream *out, HouGeoAdapter::Ptr geo, bool binary )
-	{
-		if( binary )
-			g_writer = new json::BinaryWriter( out );
-		else
-			// todo: ascii writer...
-			g_writer = new json::BinaryWriter( out );
-
-		g_writer->jsonBeginArray();
-
-		g_writer->jsonString( "pointcount" );
-		g_writer->jsonInt( geo->pointcount() );
-
-		g_writer->jsonString( "vertexcount" );
-		g_writer->jsonInt( geo->vertexcount() );
-
-		g_writer->jsonString( "primitivecount" );
-		g_writer->jsonInt( geo->primitivecount() );
-
-		// -- topology (required)
-		g_writer->jsonString( "topology" );
-		g_writer->jsonBeginArray();
-			if( geo->getTopology() )
-				exportTopology( geo->getTopology() );
-		g_writer->jsonEndArray();
-
-
-		// -- attributes
-		g_writer->jsonString( "attributes" );
-		g_writer->jsonBeginArray();
-
-			// -- point attributes
-			g_writer->jsonString( "pointattributes" );
-			g_writer->jsonBeginArray();
-				std::vector<std::string> pointAttrNames;
-				geo->getPointAttributeNames(pointAttrNames);
-				for( std::vector<std::string>::iterator it = pointAttrNames.begin(); it != pointAttrNames.end(); ++it )
-					exportAttribute( geo->getPointAttribute(*it) );
-			g_writer->jsonEndArray(); // pointattributes
-
-
-			// -- primitive attributes
-			g_writer->jsonString( "primitiveattributes" );
-			g_writer->jsonBeginArray();
-				std::vector<std::string> primitiveAttrNames;
-				geo->getPrimitiveAttributeNames(primitiveAttrNames);
-				for( std::vector<std::string>::iterator it = primitiveAttrNames.begin(); it != primitiveAttrNames.end(); ++it )
-					exportAttribute( geo->getPrimitiveAttribute(*it) );
-			g_writer->jsonEndArray(); // primitiveattributes
-
-/*
-			// -- global attributes
-			g_writer->jsonString( "globalattributes" );
-			g_writer->jsonBeginArray();
-				std::vector<std::string> globalAttrNames;
-				geo->getGlobalAttributeNames(globalAttrNames);
-				for( std::vector<std::string>::iterator it = globalAttrNames.begin(); it != globalAttrNames.end(); ++it )
-					exportAttribute( geo->getGlobalAttribute(*it) );
-			g_writer->jsonEndArray(); // globalattributes
-*/
-		g_writer->jsonEndArray(); // attributes
-
-
-		// -- primitives
-		if( geo->primitivecount() > 0 )
-		{
-			g_writer->jsonString( "primitives" );
-			g_writer->jsonBeginArray();
-
-			std::vector<HouGeoAdapter::Primitive::Ptr> primitives;
-			geo->getPrimitives(primitives);
-
-			for( auto prim : primitives )
-			{
-				if( std::dynamic_pointer_cast<HouGeoAdapter::VolumePrimitive>(prim) )
-					exportPrimitive(std::dynamic_pointer_cast<HouGeoAdapter::VolumePrimitive>(prim));
-				else
-				if( std::dynamic_pointer_cast<HouGeoAdapter::PolyPrimitive>(prim) )
-					exportPrimitive(std::dynamic_pointer_cast<HouGeoAdapter::PolyPrimitive>(prim));
-
-			}
-			g_writer->jsonEndArray(); // primitives
-		}
-
-
-
-		g_writer->jsonEndArray(); // /root
-
-		// done
-		delete g_writer;g_writer=0;
-
-		return true;
-	}
-
-
-
-
-
-
-	bool HouGeoIO::exportAttribute( HouGeoAdapter::AttributeAdapter::Ptr attr )
-	{
-		if( !attr )
-			return false;
-
-		std::string type;
-		std::string storage;
-		int size = attr->getTupleSize();
-		std::string name = attr->getName();
-
-		if( attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_NUMERIC )
-			type = "numeric";
-		else if( attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_STRING )
-			type = "string";
-
-		if( attr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32 )
-				storage = "fpreal32";
-		else if( attr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL64 )
-				storage = "fpreal64";
-		else if( attr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT32 )
-				storage = "int32";
-
-
-		// P attribute has to have 4 components, otherwise houdini will become unstable and eventually crash
-		if( (name == "P")&&(size!=4)  )
-			throw std::runtime_error( "HouGeoIO::exportAttribute: P attribute has to have 4 components, otherwise houdini will become unstable and eventually crash" );
-
-		g_writer->jsonBeginArray();
-
-
-		// attribute definition ------------
-		g_writer->jsonBeginArray();
-
-		g_writer->jsonString( "name" );
-		g_writer->jsonString( name );
-
-		g_writer->jsonString( "type" );
-		g_writer->jsonString(type);
-
-		g_writer->jsonEndArray(); // definition
-
-		// attribute content ------------
-		g_writer->jsonBeginArray();
-
-		if( attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_NUMERIC )
-		{
-			g_writer->jsonString( "size" );
-			g_writer->jsonInt( size );
-
-			g_writer->jsonString( "storage" );
-			g_writer->jsonString( storage );
-
-
-			g_writer->jsonString( "values" );
-			g_writer->jsonBeginArray();
+			if( sint64(it.second.size()) != numPoints )
+				throw std::runtime_error( "HouGeoIO::xport: point attributes differ in size" );
 
-				g_writer->jsonString( "size" );
-				g_writer->jsonInt( attr->getTupleSize() );
-
-				g_writer->jsonString( "storage" );
-				g_writer->jsonString( storage );
-
-				g_writer->jsonString( "pagesize" );
-				g_writer->jsonInt( 1024 );
-
-
-				//g_writer->jsonString( "packing" );
-				//std::vector<int> packing;
-				//attr->getPacking( packing );
-				//g_writer->jsonUniformArray( packing );
-
-				//std::cout << "CHECK " << name << std::endl;
-				//std::cout << "CHECK " << attr->getNumElements() << std::endl;
-				//std::cout << "CHECK " << attr->getTupleSize() << std::endl;
-				//attr->getRawPointer();
-
-				g_writer->jsonString( "rawpagedata" );
-				if( attr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32 )
-					g_writer->jsonUniformArray<real32>(  (const real32*) attr->getRawPointer()->ptr, attr->getNumElements()*attr->getTupleSize() );
-				else if( attr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL64 )
-					g_writer->jsonUniformArray<real64>( (const real64*) attr->getRawPointer()->ptr, attr->getNumElements()*attr->getTupleSize() );
-				else if( attr->getStorage() == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT32 )
-					g_writer->jsonUniformArray<sint32>( (const sint32*) attr->getRawPointer()->ptr, attr->getNumElements()*attr->getTupleSize() );
+		HouGeoPointWriter writer( filename, numPoints );
+		for( auto&it:pattr_v3f )
+			writer.addAttribute( it.first, 3 );
 
-			g_writer->jsonEndArray(); // values
-		}else
-		if(attr->getType() == HouGeoAdapter::AttributeAdapter::ATTR_TYPE_STRING )
+		for( sint64 i=0;i<numPoints;i+=HouGeoPointWriter::pageSize )
 		{
-			g_writer->jsonString( "size" );
-			g_writer->jsonInt( size );
-
-			g_writer->jsonString( "storage" );
-			g_writer->jsonString( "int32" );
-
-			g_writer->jsonString( "strings" );
-			g_writer->jsonBeginArray();
-				for( int i=0;i<attr->getNumElements();++i )
-					g_writer->jsonString( attr->getString(i) );
-			g_writer->jsonEndArray();
-
-			g_writer->jsonString( "indices" );
-			g_writer->jsonBeginArray();
-				g_writer->jsonString( "size" );
-				g_writer->jsonInt32( 1 );
-
-				g_writer->jsonString( "storage" );
-				g_writer->jsonString( "int32" );
-
-				g_writer->jsonString( "pagesize" );
-				g_writer->jsonInt32( 1024 );
-
-				g_writer->jsonString( "rawpagedata" );
-				std::vector<int> indices;
-				for( int i=0;i<attr->getNumElements();++i )
-					indices.push_back(i);
-				g_writer->jsonUniformArray(indices);
-
-			g_writer->jsonEndArray();
-
-
+			sint64 count = std::min<sint64>( numPoints-i, HouGeoPointWriter::pageSize );
+			int attrIndex = 0;
+			for( auto&it:pattr_v3f )
+				writer.write( attrIndex++, i, count, &it.second[i] );
 		}
 
-
-
-		g_writer->jsonEndArray(); // attribute content
-
-
-
-		g_writer->jsonEndArray(); // attribute
-
-		return true;
+		return writer.finish();
 	}
 
-	// export topo
-	// TODO: datatype is int ~~~~
-	bool HouGeoIO::exportTopology( HouGeoAdapter::Topology::Ptr topo )
-	{
-		std::vector<sint32> indices;
-		topo->getIndices(indices);
-		
-		// determine the type we use for the index array, either 16 or 32 bit integers
-		bool index_exceeds_16bit = false;
-		for( auto& i : indices )
-			if( i > std::numeric_limits<sint16>::max() )
-			{
-				index_exceeds_16bit = true;
-				break;
-			}
-
-		g_writer->jsonString( "pointref" );
-		g_writer->jsonBeginArray();
-			g_writer->jsonString( "indices" );
-			if(index_exceeds_16bit)
-				g_writer->jsonUniformArray<sint32>(indices);
-			else
-				g_writer->jsonUniformArray<sint16>(std::vector<sint16>(indices.begin(), indices.end()));
-			
-		g_writer->jsonEndArray();
 
-		return true;
-	}
 
 
-	bool HouGeoIO::exportPrimitive( HouGeoAdapter::VolumePrimitive::Ptr volume )
+	bool HouGeoIO::xport( std::ostream *out, HouGeoAdapter::Ptr geo, bool binary )
 	{
-		math::V3i res = volume->getResolution();
-
-		g_writer->jsonBeginArray();
-
-		// primitive type
-		g_writer->jsonBeginArray();
-			g_writer->jsonString("type");
-			g_writer->jsonString("Volume");
-		g_writer->jsonEndArray();
-
-		g_writer->jsonBeginArray();
-			g_writer->jsonString("vertex");
-			g_writer->jsonInt32(volume->getVertex());
-
-			g_writer->jsonString("transform");
-			math::M44f houLocalToWorldTranslation = math::M44f::TranslationMatrix(volume->getTransform().getTranslation());
-			math::M44f houLocalToWorldRotationScale = math::M44f::ScaleMatrix(0.5f)*math::M44f::TranslationMatrix(1.0,1.0,1.0)*volume->getTransform()*houLocalToWorldTranslation.inverted();
-			math::M33f transform( houLocalToWorldRotationScale.ma[0], houLocalToWorldRotationScale.ma[1], houLocalToWorldRotationScale.ma[2],
-						houLocalToWorldRotationScale.ma[4], houLocalToWorldRotationScale.ma[5], houLocalToWorldRotationScale.ma[6],
-						houLocalToWorldRotationScale.ma[8], houLocalToWorldRotationScale.ma[9], houLocalToWorldRotationScale.ma[10]);
-			g_writer->jsonUniformArray<real32>( transform.ma, 9 );
-
-			g_writer->jsonString("res");
-			g_writer->jsonUniformArray<sint32>( &res.x, 3 );
-
-			g_writer->jsonString("border");
-			g_writer->jsonBeginMap();
-				g_writer->jsonKey("type");
-				g_writer->jsonString("constant");
-				g_writer->jsonKey("value");
-				g_writer->jsonReal32(0.0f);
-			g_writer->jsonEndMap();
-
-			g_writer->jsonString("compression");
-			g_writer->jsonBeginMap();
-				g_writer->jsonKey("tolerance");
-				g_writer->jsonReal32(0.0f);
-			g_writer->jsonEndMap();
-
-			g_writer->jsonString("voxels");
-			g_writer->jsonBeginArray();
-				g_writer->jsonString("tiledarray");
-				g_writer->jsonBeginArray();
-					g_writer->jsonString("version");
-					g_writer->jsonInt32( 1 );
-
-					g_writer->jsonString("compressiontype");
-					// !!! uniform string array?
-					g_writer->jsonBeginArray();
-						g_writer->jsonString("raw");
-						g_writer->jsonString("rawfull");
-						g_writer->jsonString("constant");
-						g_writer->jsonString("fpreal16");
-						g_writer->jsonString("FP32Range");
-					g_writer->jsonEndArray();
-
-					g_writer->jsonString("tiles");
-					g_writer->jsonBeginArray();
-
-						// get first invalid tileindex in each dimension
-						math::Vec3i tileEnd;
-						tileEnd.x = res.x / 16;
-						tileEnd.y = res.y / 16;
-						tileEnd.z = res.z / 16;
-
-						// if there are some voxels remaining, add another tile
-						if( res.x%16 )
-							++tileEnd.x;
-						if( res.y%16 )
-							++tileEnd.y;
-						if( res.z%16 )
-							++tileEnd.z;
-
-
-						math::Vec3i voxelOffset; // start offset (in voxels) for current tile
-						math::Vec3i numVoxels;   // number of voxels for current tile (may differ in each dimension)
-						std::vector<real32> data;
-						int remainK = res.z;
-						for( int tk=0; tk<tileEnd.z;++tk )
-						{
-							voxelOffset.z = tk*16;
-							numVoxels.z = std::min( 16,  remainK );
-
-							int remainJ = res.y;
-							for( int tj=0; tj<tileEnd.y;++tj )
-							{
-								voxelOffset.y = tj*16;
-								numVoxels.y = std::min( 16,  remainJ );
-
-								int remainI = res.x;
-								for( int ti=0; ti<tileEnd.x;++ti )
-								{
-									voxelOffset.x = ti*16;
-									numVoxels.x = std::min( 16,  remainI );
-
-									// write tile ---
-									g_writer->jsonBeginArray();
-										g_writer->jsonString("compression");
-										g_writer->jsonInt32(0);
-										g_writer->jsonString("data");
-										data.clear();
-										math::V3i voxelEnd( voxelOffset.x + numVoxels.x, voxelOffset.y + numVoxels.y, voxelOffset.z + numVoxels.z );
-										for( int k=voxelOffset.z;k<voxelEnd.z;++k )
-											for( int j=voxelOffset.y;j<voxelEnd.y;++j )
-												for( int i=voxelOffset.x;i<voxelEnd.x;++i )
-													data.push_back(volume->getVoxel( i, j, k ));
-										g_writer->jsonUniformArray(data);
-									g_writer->jsonEndArray();
-
-									remainI -=16;
-								}
-								remainJ -=16;
-							}
-							remainK -=16;
-						}
-
-					g_writer->jsonEndArray();
-
-				g_writer->jsonEndArray();
-
-			g_writer->jsonEndArray();
-
-			g_writer->jsonString("visualization");
-			g_writer->jsonBeginMap();
-				g_writer->jsonKey("mode");
-				g_writer->jsonString("smoke");
-				g_writer->jsonKey("iso");
-				g_writer->jsonReal32(0.0f);
-				g_writer->jsonKey("density");
-				g_writer->jsonReal32(1.0f);
-			g_writer->jsonEndMap();
-
-			g_writer->jsonString("taperx");
-			g_writer->jsonReal32(1.0f);
-
-			g_writer->jsonString("tapery");
-			g_writer->jsonReal32(1.0f);
-
-
-
-		g_writer->jsonEndArray();
-
-		g_writer->jsonEndArray();
-		return true;
+		ExportOptions options;
+		options.binary = binary;
+		json::StreamSink sink( out );
+		bool result = HouGeoIO::xport( &sink, geo, options );
+		return sink.flush() && result;
 	}
 
-	bool HouGeoIO::exportPrimitive( HouGeoAdapter::PolyPrimitive::Ptr poly )
+	bool HouGeoIO::xport( json::OutputSink *sink, HouGeoAdapter::Ptr geo, const ExportOptions &options )
 	{
-		// if we have a single polygon, then we just export it as is
-
-		g_writer->jsonBeginArray();
-			if( poly->numPolys() == 1 )
-			{
-				// single poly
-				g_writer->jsonBeginArray();
-					g_writer->jsonString("type");
-					g_writer->jsonString("Poly");
-				g_writer->jsonEndArray();
-
-				g_writer->jsonBeginArray();
-					g_writer->jsonString("vertex");
-					g_writer->jsonUniformArray<sint32>( poly->vertices(0), poly->numVertices(0));
-
-					g_writer->jsonString("closed");
-					g_writer->jsonBool(false);
-				g_writer->jsonEndArray();
-			}else
-			{
-				// polygon run
-				g_writer->jsonBeginArray();
-					g_writer->jsonString("type");
-					g_writer->jsonString("run");
-					g_writer->jsonString("runtype");
-					g_writer->jsonString("Poly");
-					g_writer->jsonString("varyingfields");
-					g_writer->jsonBeginArray();
-						g_writer->jsonString("vertex");
-					g_writer->jsonEndArray();
-					g_writer->jsonString("uniformfields");
-					g_writer->jsonBeginMap();
-						g_writer->jsonKey("closed");
-						g_writer->jsonBool(poly->closed());
-					g_writer->jsonEndMap();
-				g_writer->jsonEndArray();
-
-				g_writer->jsonBeginArray();
-					int numPolys = poly->numPolys();
-					for( int i=0;i<numPolys;++i )
-					{
-						g_writer->jsonBeginArray();
-							g_writer->jsonUniformArray<sint32>( poly->vertices(i), poly->numVertices(i) );
-						g_writer->jsonEndArray();
-					}
-				g_writer->jsonEndArray();
-			}
-
-		g_writer->jsonEndArray();
-		return true;
+		HouGeoExporter exporter( sink, options );
+		return exporter.write( geo );
 	}
 
 }
@@ -0,0 +1,398 @@
+#include <houio/HouGeoIndex.h>
+#include <houio/HouGeoIO.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+
+namespace houio
+{
+	// increment whenever the layout of the index file changes
+	static const sint64 indexVersion = 3;
+
+	// size and modification time (nanoseconds where the platform provides them) of given file, returns false if the file doesnt exist
+	static bool fileStats( const std::string &path, sint64 &size, sint64 &time )
+	{
+		struct stat s;
+		if( stat( path.c_str(), &s ) != 0 )
+			return false;
+		size = sint64(s.st_size);
+#if defined(__APPLE__)
+		time = sint64(s.st_mtimespec.tv_sec)*1000000000 + sint64(s.st_mtimespec.tv_nsec);
+#elif defined(_WIN32)
+		time = sint64(s.st_mtime)*1000000000;
+#else
+		time = sint64(s.st_mtim.tv_sec)*1000000000 + sint64(s.st_mtim.tv_nsec);
+#endif
+		return true;
+	}
+
+	// FNV-1a hash of the first and the last block of given file
+	// catches files which have been rewritten with the same size within the resolution of the modification time
+	static sint64 contentHash( const std::string &path, sint64 size )
+	{
+		const sint64 blockSize = 4096;
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+		std::vector<char> block( size_t(std::min( size, 2*blockSize )) );
+		sint64 firstSize = std::min( size, blockSize );
+		in.read( block.data(), firstSize );
+		in.seekg( std::max( firstSize, size-blockSize ) );
+		in.read( block.data() + firstSize, sint64(block.size()) - firstSize );
+		if( !in )
+			return 0;
+		uint64 hash = 14695981039346656037ULL;
+		for( char c:block )
+			hash = (hash ^ ubyte(c))*1099511628211ULL;
+		return sint64(hash);
+	}
+
+	// copies a uniform int64 array from json
+	static void getInt64Array( json::ObjectPtr o, const std::string &key, std::vector<sint64> &result )
+	{
+		result.clear();
+		if( !o->hasKey(key) )
+			return;
+		json::ArrayPtr a = o->getArray(key);
+		sint64 size = a->size();
+		result.resize(size);
+		for( sint64 i=0;i<size;++i )
+			result[i] = a->get<sint64>(int(i));
+	}
+
+	HouGeoIndex::HouGeoIndex() :
+		fileSize(0),
+		fileTime(0),
+		fileHash(0),
+		pointCount(0),
+		vertexCount(0),
+		primitiveCount(0)
+	{
+	}
+
+	HouGeoIndex::Ptr HouGeoIndex::create()
+	{
+		return std::make_shared<HouGeoIndex>();
+	}
+
+	HouGeoIndex::Ptr HouGeoIndex::build( const std::string &path )
+	{
+		if( !isIndexable( path ) )
+			throw std::runtime_error( "HouGeoIndex::build: " + path + " is not a binary bgeo file" );
+		Ptr index = create();
+		if( !fileStats( path, index->fileSize, index->fileTime ) )
+			throw std::runtime_error( "HouGeoIndex::build: unable to open " + path );
+		index->fileHash = contentHash( path, index->fileSize );
+		HouGeoIO::Metadata metadata = HouGeoIO::probe( path, index );
+		if( !metadata.valid )
+			throw std::runtime_error( "HouGeoIndex::build: failed to parse " + path );
+		return index;
+	}
+
+	HouGeoIndex::Ptr HouGeoIndex::load( const std::string &path, bool writeSidecar )
+	{
+		sint64 size, time;
+		if( !fileStats( path, size, time ) )
+			throw std::runtime_error( "HouGeoIndex::load: unable to open " + path );
+
+		std::string indexPath = sidecarPath(path);
+		Ptr index = read( indexPath );
+		if( index && (index->fileSize == size) && (index->fileTime == time) && (index->fileHash == contentHash( path, size )) )
+			return index;
+
+		index = build( path );
+		if( writeSidecar && !index->write( indexPath ) )
+			std::cout << "HouGeoIndex::load: warning: unable to write " << indexPath << std::endl;
+		return index;
+	}
+
+	std::string HouGeoIndex::sidecarPath( const std::string &path )
+	{
+		return path + ".idx";
+	}
+
+	// binary json files start with the magic token
+	bool HouGeoIndex::isIndexable( const std::string &path )
+	{
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+		char c = 0;
+		return in.get( c ) && (ubyte(c) == json::Token::JID_MAGIC);
+	}
+
+	// the index is stored as binary json with one uniform array per entry field
+	bool HouGeoIndex::write( const std::string &indexPath )const
+	{
+		std::ofstream out( indexPath.c_str(), std::ios_base::out | std::ios_base::binary );
+		if( !out.good() )
+			return false;
+
+		sint64 numEntries = sint64(entries.size());
+		std::vector<sint32> types( numEntries );
+		std::vector<sint64> primitives( numEntries ), tiles( numEntries ), offsets( numEntries ), sizes( numEntries ), dataOffsets( numEntries ), dataSizes( numEntries ), numDefinitions( numEntries );
+		for( sint64 i=0;i<numEntries;++i )
+		{
+			const Entry &entry = entries[i];
+			types[i] = sint32(entry.type);
+			primitives[i] = entry.primitive;
+			tiles[i] = entry.tile;
+			offsets[i] = entry.offset;
+			sizes[i] = entry.size;
+			dataOffsets[i] = entry.dataOffset;
+			dataSizes[i] = entry.dataSize;
+			numDefinitions[i] = entry.numStringDefinitions;
+		}
+
+		// 64bit values go into uniform arrays, which keep their width
+		std::vector<sint64> header;
+		header.push_back( indexVersion );
+		header.push_back( fileSize );
+		header.push_back( fileTime );
+		header.push_back( fileHash );
+		header.push_back( pointCount );
+		header.push_back( vertexCount );
+		header.push_back( primitiveCount );
+
+		std::vector<sint64> stringIds( stringDefinitions.size() );
+		for( size_t i=0;i<stringDefinitions.size();++i )
+			stringIds[i] = stringDefinitions[i].first;
+
+		json::BinaryWriter writer( &out );
+		writer.jsonBeginArray();
+
+		writer.jsonString( "header" );
+		writer.jsonUniformArray( header );
+
+		writer.jsonString( "types" );
+		writer.jsonUniformArray( types );
+
+		writer.jsonString( "names" );
+		writer.jsonBeginArray();
+		for( auto &entry:entries )
+			writer.jsonString( entry.name );
+		writer.jsonEndArray();
+
+		writer.jsonString( "primitives" );
+		writer.jsonUniformArray( primitives );
+		writer.jsonString( "tiles" );
+		writer.jsonUniformArray( tiles );
+		writer.jsonString( "offsets" );
+		writer.jsonUniformArray( offsets );
+		writer.jsonString( "sizes" );
+		writer.jsonUniformArray( sizes );
+		writer.jsonString( "dataoffsets" );
+		writer.jsonUniformArray( dataOffsets );
+		writer.jsonString( "datasizes" );
+		writer.jsonUniformArray( dataSizes );
+		writer.jsonString( "numstringdefinitions" );
+		writer.jsonUniformArray( numDefinitions );
+
+		writer.jsonString( "stringids" );
+		writer.jsonUniformArray( stringIds );
+		writer.jsonString( "strings" );
+		writer.jsonBeginArray();
+		for( auto &definition:stringDefinitions )
+			writer.jsonString( definition.second );
+		writer.jsonEndArray();
+
+		writer.jsonEndArray();
+
+		// the writer buffers its output
+		return writer.flush() && out.good();
+	}
+
+	HouGeoIndex::Ptr HouGeoIndex::read( const std::string &indexPath )
+	{
+		std::ifstream in( indexPath.c_str(), std::ios_base::in | std::ios_base::binary );
+		if( !in.good() )
+			return Ptr();
+
+		json::JSONReader reader;
+		json::Parser p;
+		if( !p.parse( &in, &reader ) )
+			return Ptr();
+		json::Value root = reader.getRoot();
+		if( !root.isArray() )
+			return Ptr();
+		json::ObjectPtr o = HouGeo::toObject( root.asArray() );
+
+		std::vector<sint64> header;
+		getInt64Array( o, "header", header );
+		if( (header.size() < 7)||(header[0] != indexVersion) )
+			return Ptr();
+
+		Ptr index = create();
+		index->fileSize = header[1];
+		index->fileTime = header[2];
+		index->fileHash = header[3];
+		index->pointCount = header[4];
+		index->vertexCount = header[5];
+		index->primitiveCount = header[6];
+
+		std::vector<sint64> primitives, tiles, offsets, sizes, dataOffsets, dataSizes, numDefinitions, stringIds;
+		getInt64Array( o, "primitives", primitives );
+		getInt64Array( o, "tiles", tiles );
+		getInt64Array( o, "offsets", offsets );
+		getInt64Array( o, "sizes", sizes );
+		getInt64Array( o, "dataoffsets", dataOffsets );
+		getInt64Array( o, "datasizes", dataSizes );
+		getInt64Array( o, "numstringdefinitions", numDefinitions );
+		getInt64Array( o, "stringids", stringIds );
+		json::ArrayPtr types = o->getArray( "types" );
+		json::ArrayPtr names = o->getArray( "names" );
+		json::ArrayPtr strings = o->getArray( "strings" );
+
+		sint64 numEntries = types->size();
+		if( (names->size() != numEntries)||(sint64(primitives.size()) != numEntries)||(sint64(tiles.size()) != numEntries)||
+			(sint64(offsets.size()) != numEntries)||(sint64(sizes.size()) != numEntries)||(sint64(dataOffsets.size()) != numEntries)||
+			(sint64(dataSizes.size()) != numEntries)||(sint64(numDefinitions.size()) != numEntries)||(sint64(stringIds.size()) != strings->size()) )
+		{
+			std::cout << "HouGeoIndex::read: warning: inconsistent index " << indexPath << std::endl;
+			return Ptr();
+		}
+
+		index->entries.resize( numEntries );
+		for( sint64 i=0;i<numEntries;++i )
+		{
+			Entry &entry = index->entries[i];
+			entry.type = EntryType(types->get<sint32>(int(i)));
+			entry.name = names->get<std::string>(int(i));
+			entry.primitive = primitives[i];
+			entry.tile = tiles[i];
+			entry.offset = offsets[i];
+			entry.size = sizes[i];
+			entry.dataOffset = dataOffsets[i];
+			entry.dataSize = dataSizes[i];
+			entry.numStringDefinitions = numDefinitions[i];
+		}
+
+		index->stringDefinitions.resize( stringIds.size() );
+		for( size_t i=0;i<stringIds.size();++i )
+			index->stringDefinitions[i] = std::make_pair( stringIds[i], strings->get<std::string>(int(i)) );
+
+		return index;
+	}
+
+	const HouGeoIndex::Entry* HouGeoIndex::find( EntryType type, const std::string &name )const
+	{
+		for( auto &entry:entries )
+			if( (entry.type == type)&&(entry.name == name) )
+				return &entry;
+		return 0;
+	}
+
+	void HouGeoIndex::getEntries( EntryType type, std::vector<const Entry*> &result )const
+	{
+		result.clear();
+		for( auto &entry:entries )
+			if( entry.type == type )
+				result.push_back( &entry );
+	}
+
+	// parses the entry which starts at the current position of in
+	static json::Value parseValue( std::istream *in, const HouGeoIndex::Entry &entry, const std::vector<std::pair<sint64, std::string>> &stringDefinitions )
+	{
+		json::Parser p;
+		// tokens within the entry may reference strings which have been defined earlier in the file
+		for( sint64 i=0;(i<entry.numStringDefinitions)&&(i<sint64(stringDefinitions.size()));++i )
+			p.strings[stringDefinitions[i].first] = stringDefinitions[i].second;
+
+		json::JSONReader reader;
+		if( !p.parseValue( in, &reader ) )
+			throw std::runtime_error( "HouGeoIndex::parseEntry: failed to parse entry " + entry.name );
+		return reader.getRoot();
+	}
+
+	json::Value HouGeoIndex::parseEntry( std::istream *in, const Entry &entry )const
+	{
+		in->clear();
+		in->seekg( entry.offset );
+		return parseValue( in, entry, stringDefinitions );
+	}
+
+	json::Value HouGeoIndex::parseEntry( const char *data, const Entry &entry )const
+	{
+		json::MemoryBuffer buffer( const_cast<char *>(data), size_t(entry.size) );
+		std::istream in( &buffer );
+		return parseValue( &in, entry, stringDefinitions );
+	}
+
+	HouGeo::HouAttribute::Ptr HouGeoIndex::loadAttribute( std::istream *in, EntryType type, const std::string &name )const
+	{
+		sint64 elementCount = 0;
+		switch( type )
+		{
+		case ENTRY_POINT_ATTRIBUTE:elementCount = pointCount;break;
+		case ENTRY_VERTEX_ATTRIBUTE:elementCount = vertexCount;break;
+		case ENTRY_PRIMITIVE_ATTRIBUTE:elementCount = primitiveCount;break;
+		case ENTRY_GLOBAL_ATTRIBUTE:elementCount = 1;break;
+		default:
+			throw std::runtime_error( "HouGeoIndex::loadAttribute: entry type is not an attribute" );
+		};
+
+		const Entry *entry = find( type, name );
+		if( !entry )
+			return HouGeo::HouAttribute::Ptr();
+		json::Value root = parseEntry( in, *entry );
+		return HouGeo::loadAttribute( root.asArray(), elementCount );
+	}
+
+	HouGeo::Ptr HouGeoIndex::loadPrimitives( std::istream *in, sint64 first, sint64 count )const
+	{
+		HouGeo::Ptr geo = HouGeo::create();
+
+		// polygons reference the topology and volumes take their position from the points
+		if( const Entry *topology = find( ENTRY_TOPOLOGY, "" ) )
+			geo->loadTopology( HouGeo::toObject( parseEntry( in, *topology ).asArray() ) );
+		for( auto &entry:entries )
+			if( entry.type == ENTRY_POINT_ATTRIBUTE )
+				geo->setPointAttribute( HouGeo::loadAttribute( parseEntry( in, entry ).asArray(), pointCount ) );
+
+		HouGeo::SharedPrimitiveData sharedPrimitiveData;
+		for( auto &entry:entries )
+			if( (entry.type == ENTRY_PRIMITIVE)&&(entry.primitive >= first)&&(entry.primitive < first+count) )
+				geo->loadPrimitive( parseEntry( in, entry ).asArray(), sharedPrimitiveData, entry.primitive );
+		return geo;
+	}
+
+	void HouGeoIndex::loadTiles( std::istream *in, sint64 primitive, const std::vector<sint64> &tiles, std::vector<json::ArrayPtr> &result )const
+	{
+		// tile entries are stored in the order of the tiles
+		std::vector<const Entry*> tileEntries;
+		for( auto &entry:entries )
+			if( (entry.type == ENTRY_VOLUME_TILE)&&(entry.primitive == primitive) )
+				tileEntries.push_back( &entry );
+
+		result.clear();
+		for( auto tile:tiles )
+		{
+			if( (tile < 0)||(tile >= sint64(tileEntries.size()))||(tileEntries[tile]->tile != tile) )
+				throw std::runtime_error( "HouGeoIndex::loadTiles: tile " + json::toString(tile) + " of primitive " + json::toString(primitive) + " is not indexed" );
+			result.push_back( parseEntry( in, *tileEntries[tile] ).asArray() );
+		}
+	}
+
+	HouGeo::TileLoader HouGeoIndex::tileLoader( Ptr index, std::shared_ptr<std::istream> in )
+	{
+		typedef std::map<std::pair<sint64, sint64>, const Entry*> TileEntries;
+		std::shared_ptr<TileEntries> tileEntries = std::make_shared<TileEntries>();
+		for( auto &entry:index->entries )
+			if( entry.type == ENTRY_VOLUME_TILE )
+				(*tileEntries)[std::make_pair( entry.primitive, entry.tile )] = &entry;
+
+		// volumes may be decoded from multiple threads when loaded lazily, they share the stream
+		std::shared_ptr<std::mutex> mutex = std::make_shared<std::mutex>();
+		return [=]( sint64 primitive, sint64 tile )
+		{
+			TileEntries::const_iterator it = tileEntries->find( std::make_pair( primitive, tile ) );
+			if( it == tileEntries->end() )
+				throw std::runtime_error( "HouGeoIndex::tileLoader: tile " + json::toString(tile) + " of primitive " + json::toString(primitive) + " is not indexed" );
+			std::lock_guard<std::mutex> lock( *mutex );
+			return index->parseEntry( in.get(), *it->second ).asArray();
+		};
+	}
+}
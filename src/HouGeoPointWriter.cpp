@@ -0,0 +1,262 @@
+#include <houio/HouGeoPointWriter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+
+
+namespace houio
+{
+	// uniform array type used for the rawpagedata of given storage
+	static json::Token::Type uniformArrayType( HouGeoAdapter::AttributeAdapter::Storage storage )
+	{
+		switch( storage )
+		{
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL16:return json::Token::JID_REAL16;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32:return json::Token::JID_REAL32;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL64:return json::Token::JID_REAL64;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT8:return json::Token::JID_INT8;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT16:return json::Token::JID_INT16;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT32:return json::Token::JID_INT32;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INT64:return json::Token::JID_INT64;
+		case HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_UINT8:return json::Token::JID_UINT8;
+		default:
+			return json::Token::JID_NULL;
+		};
+	}
+
+	HouGeoPointWriter::HouGeoPointWriter( std::ostream *out, sint64 numPoints ) :
+		m_out(out),
+		m_numPoints(numPoints),
+		m_end(0),
+		m_headerWritten(false),
+		m_finished(false)
+	{
+	}
+
+	HouGeoPointWriter::HouGeoPointWriter( const std::string &filename, sint64 numPoints ) :
+		m_file( new std::ofstream( filename.c_str(), std::ios_base::out | std::ios_base::binary ) ),
+		m_numPoints(numPoints),
+		m_end(0),
+		m_headerWritten(false),
+		m_finished(false)
+	{
+		m_out = m_file.get();
+	}
+
+	HouGeoPointWriter::~HouGeoPointWriter()
+	{
+		if( !m_finished )
+		{
+			try
+			{
+				finish();
+			}catch( std::exception &e )
+			{
+				std::cout << "HouGeoPointWriter: " << e.what() << std::endl;
+			}
+		}
+	}
+
+	HouGeoPointWriter::Ptr HouGeoPointWriter::create( const std::string &filename, sint64 numPoints )
+	{
+		return std::make_shared<HouGeoPointWriter>( filename, numPoints );
+	}
+
+	int HouGeoPointWriter::addAttribute( const std::string &name, int tupleSize, Storage storage )
+	{
+		if( m_headerWritten )
+			throw std::runtime_error( "HouGeoPointWriter::addAttribute: attributes have to be added before the first write" );
+		if( getAttributeIndex(name) >= 0 )
+			throw std::runtime_error( "HouGeoPointWriter::addAttribute: attribute " + name + " already exists" );
+		if( uniformArrayType(storage) == json::Token::JID_NULL )
+			throw std::runtime_error( "HouGeoPointWriter::addAttribute: unsupported storage for attribute " + name );
+
+		AttributeInfo attr;
+		attr.name = name;
+		attr.tupleSize = tupleSize;
+		attr.fileTupleSize = tupleSize;
+		attr.storage = storage;
+		attr.payload = 0;
+		attr.numPointsWritten = 0;
+
+		// P attribute has to have 4 components, otherwise houdini will become unstable and eventually crash
+		if( name == "P" )
+		{
+			if( (tupleSize == 3)&&(storage == HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_FPREAL32) )
+				attr.fileTupleSize = 4;
+			else
+			if( tupleSize != 4 )
+				throw std::runtime_error( "HouGeoPointWriter::addAttribute: P attribute has to have 3 float or 4 components" );
+		}
+
+		m_attributes.push_back( attr );
+		return int(m_attributes.size())-1;
+	}
+
+	int HouGeoPointWriter::getAttributeIndex( const std::string &name )const
+	{
+		for( size_t i=0;i<m_attributes.size();++i )
+			if( m_attributes[i].name == name )
+				return int(i);
+		return -1;
+	}
+
+	void HouGeoPointWriter::write( int attribute, sint64 firstPoint, sint64 numPoints, const void *data )
+	{
+		if( !m_headerWritten )
+			writeHeader();
+		if( (attribute < 0)||(attribute >= int(m_attributes.size())) )
+			throw std::runtime_error( "HouGeoPointWriter::write: invalid attribute index" );
+		if( (firstPoint < 0)||(numPoints < 0)||(firstPoint + numPoints > m_numPoints) )
+			throw std::runtime_error( "HouGeoPointWriter::write: point range exceeds point count" );
+
+		AttributeInfo &attr = m_attributes[attribute];
+		int componentSize = HouGeoAdapter::AttributeAdapter::storageSize( attr.storage );
+		sint64 elementSize = componentSize*attr.fileTupleSize;
+
+		m_out->seekp( attr.payload + firstPoint*elementSize );
+		if( attr.fileTupleSize == attr.tupleSize )
+			m_out->write( (const char *)data, numPoints*elementSize );
+		else
+		{
+			// P is extended to homogeneous coordinates one page at a time
+			const math::V3f *src = (const math::V3f *)data;
+			std::vector<math::V4f> page( std::min<sint64>( numPoints, pageSize ) );
+			for( sint64 i=0;i<numPoints;i+=pageSize )
+			{
+				sint64 count = std::min<sint64>( numPoints-i, pageSize );
+				for( sint64 j=0;j<count;++j )
+					page[j] = math::V4f( src[i+j].x, src[i+j].y, src[i+j].z, 1.0f );
+				m_out->write( (const char *)page.data(), count*sizeof(math::V4f) );
+			}
+		}
+		attr.numPointsWritten += numPoints;
+
+		if( !m_out->good() )
+			throw std::runtime_error( "HouGeoPointWriter::write: failed to write to stream" );
+	}
+
+	bool HouGeoPointWriter::finish()
+	{
+		if( m_finished )
+			return true;
+		if( !m_headerWritten )
+			writeHeader();
+		m_finished = true;
+
+		// points which havent been written remain zero
+		bool complete = true;
+		for( auto &attr:m_attributes )
+			if( attr.numPointsWritten < m_numPoints )
+			{
+				std::cout << "HouGeoPointWriter::finish: warning: attribute " << attr.name << " has not been written completely\n";
+				complete = false;
+			}
+
+		m_out->seekp( m_end );
+		m_out->flush();
+		m_writer.reset();
+		if( m_file )
+			m_file->close();
+		return complete;
+	}
+
+	// writes the complete file with gaps for the rawpagedata which are filled by write
+	void HouGeoPointWriter::writeHeader()
+	{
+		m_headerWritten = true;
+		m_writer.reset( new json::BinaryWriter( m_out ) );
+
+		m_writer->jsonBeginArray();
+
+		m_writer->jsonString( "pointcount" );
+		m_writer->jsonInt( m_numPoints );
+
+		m_writer->jsonString( "vertexcount" );
+		m_writer->jsonInt( 0 );
+
+		m_writer->jsonString( "primitivecount" );
+		m_writer->jsonInt( 0 );
+
+		m_writer->jsonString( "topology" );
+		m_writer->jsonBeginArray();
+		m_writer->jsonEndArray();
+
+		m_writer->jsonString( "attributes" );
+		m_writer->jsonBeginArray();
+
+			m_writer->jsonString( "pointattributes" );
+			m_writer->jsonBeginArray();
+				for( auto &attr:m_attributes )
+					writeAttribute( attr );
+			m_writer->jsonEndArray(); // pointattributes
+
+			m_writer->jsonString( "primitiveattributes" );
+			m_writer->jsonBeginArray();
+			m_writer->jsonEndArray(); // primitiveattributes
+
+		m_writer->jsonEndArray(); // attributes
+
+		m_writer->jsonEndArray(); // /root
+
+		m_writer->flush();
+		m_end = m_out->tellp();
+		if( m_end < 0 )
+			throw std::runtime_error( "HouGeoPointWriter: output stream is not seekable" );
+	}
+
+	// same layout as HouGeoExporter::exportAttribute
+	void HouGeoPointWriter::writeAttribute( AttributeInfo &attr )
+	{
+		std::string storage = HouGeoAdapter::AttributeAdapter::storageName( attr.storage );
+
+		m_writer->jsonBeginArray();
+
+		// attribute definition ------------
+		m_writer->jsonBeginArray();
+		m_writer->jsonString( "name" );
+		m_writer->jsonString( attr.name );
+		m_writer->jsonString( "type" );
+		m_writer->jsonString( "numeric" );
+		m_writer->jsonEndArray(); // definition
+
+		// attribute content ------------
+		m_writer->jsonBeginArray();
+
+		m_writer->jsonString( "size" );
+		m_writer->jsonInt( attr.fileTupleSize );
+
+		m_writer->jsonString( "storage" );
+		m_writer->jsonString( storage );
+
+		m_writer->jsonString( "values" );
+		m_writer->jsonBeginArray();
+
+			m_writer->jsonString( "size" );
+			m_writer->jsonInt( attr.fileTupleSize );
+
+			m_writer->jsonString( "storage" );
+			m_writer->jsonString( storage );
+
+			m_writer->jsonString( "pagesize" );
+			m_writer->jsonInt( pageSize );
+
+			// the payload is skipped and filled in by write
+			m_writer->jsonString( "rawpagedata" );
+			sint64 numComponents = m_numPoints*attr.fileTupleSize;
+			m_writer->jsonBeginUniformArray( uniformArrayType(attr.storage), numComponents );
+			m_writer->flush();
+			attr.payload = m_out->tellp();
+			if( attr.payload < 0 )
+				throw std::runtime_error( "HouGeoPointWriter: output stream is not seekable" );
+			m_out->seekp( attr.payload + numComponents*HouGeoAdapter::AttributeAdapter::storageSize( attr.storage ) );
+
+		m_writer->jsonEndArray(); // values
+
+		m_writer->jsonEndArray(); // attribute content
+
+		m_writer->jsonEndArray(); // attribute
+	}
+}
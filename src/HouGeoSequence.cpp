@@ -0,0 +1,380 @@
+#include <houio/HouGeoSequence.h>
+#include <houio/HouGeoIO.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+
+
+namespace houio
+{
+	HouGeoSequence::Stats::Stats() :
+		hits(0),
+		misses(0),
+		stalls(0),
+		stallTime(0.0),
+		prefetches(0),
+		evictions(0),
+		bytes(0),
+		numFrames(0),
+		sharedEntries(0),
+		decodedEntries(0)
+	{
+	}
+
+	HouGeoSequence::HouGeoSequence( const std::string &pattern, int firstFrame, int lastFrame, Content content, int numPrefetch, sint64 byteBudget, int numThreads ) :
+		m_pattern(pattern),
+		m_firstFrame(firstFrame),
+		m_lastFrame(lastFrame),
+		m_content(content),
+		m_numPrefetch(std::max(numPrefetch, 0)),
+		m_byteBudget(byteBudget),
+		m_reuseTopology(false),
+		m_lastRequested(firstFrame-1),
+		m_stop(false)
+	{
+		if( m_numPrefetch > 0 )
+			for( int i=0;i<std::max(numThreads, 1);++i )
+				m_threads.push_back( std::thread( &HouGeoSequence::worker, this ) );
+	}
+
+	HouGeoSequence::~HouGeoSequence()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_stop = true;
+		}
+		m_queueCondition.notify_all();
+		for( auto &thread:m_threads )
+			thread.join();
+	}
+
+	HouGeoSequence::Ptr HouGeoSequence::create( const std::string &pattern, int firstFrame, int lastFrame, Content content, int numPrefetch, sint64 byteBudget, int numThreads )
+	{
+		return std::make_shared<HouGeoSequence>( pattern, firstFrame, lastFrame, content, numPrefetch, byteBudget, numThreads );
+	}
+
+	std::string HouGeoSequence::framePath( const std::string &pattern, int frame )
+	{
+		std::string result;
+		size_t pos = 0;
+		while( pos < pattern.size() )
+		{
+			size_t var = pattern.find( "$F", pos );
+			if( var == std::string::npos )
+			{
+				result += pattern.substr( pos );
+				break;
+			}
+			result += pattern.substr( pos, var-pos );
+
+			// optional padding
+			size_t end = var + 2;
+			while( (end < pattern.size())&&isdigit(pattern[end]) )
+				++end;
+			int padding = end > var+2 ? std::atoi( pattern.substr( var+2, end-var-2 ).c_str() ) : 0;
+
+			std::ostringstream number;
+			if( frame < 0 )
+				number << "-" << std::setw(padding) << std::setfill('0') << -frame;
+			else
+				number << std::setw(padding) << std::setfill('0') << frame;
+			result += number.str();
+			pos = end;
+		}
+		return result;
+	}
+
+	HouGeoSequence::Frame HouGeoSequence::get( int frame )
+	{
+		if( (frame < m_firstFrame)||(frame > m_lastFrame) )
+			return Frame();
+
+		std::unique_lock<std::mutex> lock( m_mutex );
+
+		schedule( frame );
+
+		auto start = std::chrono::steady_clock::now();
+		bool stalled = false;
+		while( true )
+		{
+			auto it = m_entries.find( frame );
+			if( (it != m_entries.end())&&(it->second.state == STATE_LOADED) )
+			{
+				if( stalled )
+					m_stats.stallTime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+				else
+					++m_stats.hits;
+				touch( frame );
+				return it->second.frame;
+			}
+
+			if( !stalled )
+				++m_stats.stalls;
+			if( (it != m_entries.end())&&(it->second.state == STATE_LOADING) )
+			{
+				// a worker is already on it
+				if( !stalled )
+					++m_stats.hits;
+				stalled = true;
+				m_loadedCondition.wait( lock );
+				continue;
+			}
+			stalled = true;
+
+			// not in the cache and not in flight (queued frames are taken over by the caller)
+			++m_stats.misses;
+			if( it != m_entries.end() )
+				m_queue.erase( std::remove( m_queue.begin(), m_queue.end(), frame ), m_queue.end() );
+			m_entries[frame].state = STATE_LOADING;
+
+			lock.unlock();
+			sint64 bytes = 0;
+			Frame data = load( frame, bytes );
+			lock.lock();
+
+			loaded( frame, data, bytes );
+			m_stats.stallTime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+			return data;
+		}
+	}
+
+	HouGeo::Ptr HouGeoSequence::getHouGeo( int frame )
+	{
+		return get( frame ).houGeo;
+	}
+
+	Geometry::Ptr HouGeoSequence::getGeometry( int frame )
+	{
+		return get( frame ).geometry;
+	}
+
+	ScalarField::Ptr HouGeoSequence::getVolume( int frame )
+	{
+		return get( frame ).volume;
+	}
+
+	void HouGeoSequence::setTopologyReuse( bool reuse )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_reuseTopology = reuse;
+		if( !reuse )
+			m_reference.reset();
+	}
+
+	HouGeoSequence::Stats HouGeoSequence::getStats()const
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		return m_stats;
+	}
+
+	void HouGeoSequence::resetStats()
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		Stats stats;
+		stats.bytes = m_stats.bytes;
+		stats.numFrames = m_stats.numFrames;
+		m_stats = stats;
+	}
+
+	void HouGeoSequence::clear()
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		// frames which are being loaded are dropped when they arrive
+		m_entries.clear();
+		m_lru.clear();
+		m_queue.clear();
+		m_stats.bytes = 0;
+		m_stats.numFrames = 0;
+		m_loadedCondition.notify_all();
+	}
+
+	int HouGeoSequence::firstFrame()const
+	{
+		return m_firstFrame;
+	}
+
+	int HouGeoSequence::lastFrame()const
+	{
+		return m_lastFrame;
+	}
+
+	HouGeo::Ptr HouGeoSequence::importHouGeo( const std::string &path )
+	{
+		HouGeoIO::SequenceFrame::Ptr reference;
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			if( m_reuseTopology )
+				reference = m_reference ? m_reference : std::make_shared<HouGeoIO::SequenceFrame>();
+		}
+
+		if( !reference )
+		{
+			std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+			return HouGeoIO::import( &in );
+		}
+
+		// frames loaded concurrently all use the same reference, which is fine as long as the topology doesnt change
+		HouGeoIO::SequenceFrame::Ptr sequenceFrame = HouGeoIO::importFrame( path, reference );
+
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if( sequenceFrame->houGeo && m_reuseTopology )
+			m_reference = sequenceFrame;
+		m_stats.sharedEntries += sequenceFrame->numShared;
+		m_stats.decodedEntries += sequenceFrame->numDecoded;
+		return sequenceFrame->houGeo;
+	}
+
+	HouGeoSequence::Frame HouGeoSequence::load( int frame, sint64 &bytes )
+	{
+		std::string path = framePath( m_pattern, frame );
+		Frame result;
+		try
+		{
+			switch( m_content )
+			{
+			case CONTENT_HOUGEO:
+				result.houGeo = importHouGeo( path );
+				break;
+			case CONTENT_GEOMETRY:
+				result.geometry = HouGeoIO::importGeometry( importHouGeo( path ) );
+				break;
+			case CONTENT_VOLUME:
+				result.volume = HouGeoIO::importVolume( path );
+				break;
+			};
+		}catch( std::exception &e )
+		{
+			std::cout << "HouGeoSequence::load: failed to load " << path << ": " << e.what() << std::endl;
+		}
+		bytes = memorySize( result, path );
+		return result;
+	}
+
+	// decoded size for geometry and volumes, file size for HouGeo (close to the decoded size since bgeo stores raw arrays)
+	sint64 HouGeoSequence::memorySize( const Frame &frame, const std::string &path )
+	{
+		sint64 size = 0;
+		if( frame.geometry )
+		{
+			for( auto &attr:frame.geometry->m_attributes )
+				size += sint64(attr.second->numElements())*attr.second->elementSize();
+			size += sint64(frame.geometry->m_indexBuffer.size())*sizeof(unsigned int);
+		}
+		if( frame.volume )
+		{
+			math::V3i res = frame.volume->getResolution();
+			size += sint64(res.x)*res.y*res.z*sizeof(float);
+		}
+		if( frame.houGeo )
+		{
+			std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate );
+			size += std::max<sint64>( sint64(in.tellg()), 0 );
+		}
+		return size;
+	}
+
+	// frames which failed to load are not cached, so that the next request tries again
+	void HouGeoSequence::loaded( int frame, const Frame &data, sint64 bytes )
+	{
+		auto it = m_entries.find( frame );
+		if( (it != m_entries.end())&&!data.houGeo&&!data.geometry&&!data.volume )
+			m_entries.erase( it );
+		else
+		if( it != m_entries.end() )
+		{
+			Entry &entry = it->second;
+			entry.state = STATE_LOADED;
+			entry.frame = data;
+			entry.bytes = bytes;
+			m_lru.push_front( frame );
+			entry.lru = m_lru.begin();
+			m_stats.bytes += entry.bytes;
+			++m_stats.numFrames;
+			evict();
+		}
+		m_loadedCondition.notify_all();
+	}
+
+	void HouGeoSequence::touch( int frame )
+	{
+		Entry &entry = m_entries[frame];
+		m_lru.splice( m_lru.begin(), m_lru, entry.lru );
+	}
+
+	void HouGeoSequence::schedule( int frame )
+	{
+		int direction = frame < m_lastRequested ? -1 : 1;
+		m_lastRequested = frame;
+
+		// frames which havent been started yet and are outside the new window are dropped
+		std::deque<int> queue;
+		for( int i=1;i<=m_numPrefetch;++i )
+		{
+			int f = frame + i*direction;
+			if( (f < m_firstFrame)||(f > m_lastFrame) )
+				break;
+			auto it = m_entries.find( f );
+			if( it == m_entries.end() )
+				m_entries[f].state = STATE_QUEUED;
+			else
+			if( it->second.state != STATE_QUEUED )
+				continue;
+			queue.push_back( f );
+		}
+		for( auto f:m_queue )
+			if( std::find( queue.begin(), queue.end(), f ) == queue.end() )
+				m_entries.erase( f );
+		m_queue.swap( queue );
+		if( !m_queue.empty() )
+			m_queueCondition.notify_all();
+	}
+
+	// drops least recently used frames until the cache fits into the budget
+	// the most recently requested frame is always kept
+	void HouGeoSequence::evict()
+	{
+		while( (m_stats.bytes > m_byteBudget)&&(m_lru.size() > 1) )
+		{
+			int frame = m_lru.back();
+			if( frame == m_lastRequested )
+			{
+				m_lru.splice( m_lru.begin(), m_lru, std::prev(m_lru.end()) );
+				continue;
+			}
+			m_lru.pop_back();
+			auto it = m_entries.find( frame );
+			m_stats.bytes -= it->second.bytes;
+			--m_stats.numFrames;
+			++m_stats.evictions;
+			m_entries.erase( it );
+		}
+	}
+
+	void HouGeoSequence::worker()
+	{
+		std::unique_lock<std::mutex> lock( m_mutex );
+		while( true )
+		{
+			m_queueCondition.wait( lock, [this]{ return m_stop || !m_queue.empty(); } );
+			if( m_stop )
+				return;
+
+			int frame = m_queue.front();
+			m_queue.pop_front();
+			m_entries[frame].state = STATE_LOADING;
+
+			lock.unlock();
+			sint64 bytes = 0;
+			Frame data = load( frame, bytes );
+			lock.lock();
+
+			++m_stats.prefetches;
+			loaded( frame, data, bytes );
+		}
+	}
+}
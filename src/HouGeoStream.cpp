@@ -0,0 +1,401 @@
+#include <houio/HouGeoStream.h>
+#include <houio/json.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+
+
+namespace houio
+{
+	namespace
+	{
+		enum StreamFrameType
+		{
+			FRAME_OTHER,
+			FRAME_ROOT,
+			FRAME_ATTRIBUTES,
+			FRAME_ATTRIBUTE_LIST,
+			FRAME_ATTRIBUTE,
+			FRAME_ATTRIBUTE_DEFINITION,
+			FRAME_ATTRIBUTE_DATA,
+			FRAME_VALUES,
+			FRAME_PACKING,
+			FRAME_CONSTANT_PAGE_FLAGS,
+			FRAME_CONSTANT_PACK_FLAGS
+		};
+
+		// array or map which is currently being parsed
+		struct StreamFrame : public json::KeyValueFrame
+		{
+			StreamFrameType                            type;
+		};
+
+		// json handler which keeps track of where in the bgeo structure the parser currently is
+		// and streams the rawpagedata of point and vertex attributes page by page
+		struct StreamHandler : public json::KeyValueHandler<StreamFrame>
+		{
+			// state of the attribute which is currently being parsed
+			struct AttributeState
+			{
+				std::string                            name;
+				std::string                            type;
+				HouGeoStream::Owner                    owner;
+				HouGeoStream::Storage                  storage;
+				int                                    tupleSize;
+				int                                    pageSize;
+				std::vector<int>                       packing;
+				std::vector<std::vector<bool>>         constantPageFlags; // per pack and page
+			};
+
+			StreamHandler( HouGeoStream::Handler *handler ) :
+				m_handler(handler),
+				m_pointCount(0),
+				m_vertexCount(0),
+				m_primitiveCount(0),
+				m_countsReported(false)
+			{
+			}
+
+			void reportCounts()
+			{
+				if( !m_countsReported )
+					m_handler->counts( m_pointCount, m_vertexCount, m_primitiveCount );
+				m_countsReported = true;
+			}
+
+			virtual void beginFrame( StreamFrame &frame, const StreamFrame *parent, const std::string &key )override
+			{
+				frame.type = FRAME_OTHER;
+				if( !parent )
+				{
+					frame.type = FRAME_ROOT;
+					return;
+				}
+
+				switch( parent->type )
+				{
+				case FRAME_ROOT:
+					if( key == "attributes" )
+					{
+						frame.type = FRAME_ATTRIBUTES;
+						reportCounts();
+					}
+					break;
+				case FRAME_ATTRIBUTES:
+					if( (key == "pointattributes")||(key == "vertexattributes") )
+					{
+						frame.type = FRAME_ATTRIBUTE_LIST;
+						m_owner = key == "pointattributes" ? HouGeoStream::OWNER_POINT : HouGeoStream::OWNER_VERTEX;
+					}
+					break;
+				case FRAME_ATTRIBUTE_LIST:
+					frame.type = FRAME_ATTRIBUTE;
+					m_attr = AttributeState();
+					m_attr.owner = m_owner;
+					m_attr.storage = HouGeoAdapter::AttributeAdapter::ATTR_STORAGE_INVALID;
+					m_attr.tupleSize = 1;
+					m_attr.pageSize = 1024;
+					break;
+				case FRAME_ATTRIBUTE:
+					if( parent->index == 0 )
+						frame.type = FRAME_ATTRIBUTE_DEFINITION;
+					else
+					if( parent->index == 1 )
+						frame.type = FRAME_ATTRIBUTE_DATA;
+					break;
+				case FRAME_ATTRIBUTE_DATA:
+					if( key == "values" )
+						frame.type = FRAME_VALUES;
+					break;
+				case FRAME_VALUES:
+					if( key == "packing" )
+						frame.type = FRAME_PACKING;
+					else
+					if( key == "constantpageflags" )
+						frame.type = FRAME_CONSTANT_PAGE_FLAGS;
+					break;
+				case FRAME_CONSTANT_PAGE_FLAGS:
+					frame.type = FRAME_CONSTANT_PACK_FLAGS;
+					m_attr.constantPageFlags.push_back( std::vector<bool>() );
+					break;
+				default:
+					break;
+				};
+			}
+
+			virtual void value( StreamFrame &frame, const std::string *string, sint64 intValue, bool boolValue )override
+			{
+				if( frame.isValue() )
+				{
+					const std::string &key = frame.key;
+					switch( frame.type )
+					{
+					case FRAME_ROOT:
+						if( key == "pointcount" )
+							m_pointCount = intValue;
+						else
+						if( key == "vertexcount" )
+							m_vertexCount = intValue;
+						else
+						if( key == "primitivecount" )
+							m_primitiveCount = intValue;
+						break;
+					case FRAME_ATTRIBUTE_DEFINITION:
+						if( string && (key == "name") )
+							m_attr.name = *string;
+						else
+						if( string && (key == "type") )
+							m_attr.type = *string;
+						break;
+					case FRAME_ATTRIBUTE_DATA:
+					case FRAME_VALUES:
+						if( string && (key == "storage") )
+							m_attr.storage = HouGeoAdapter::AttributeAdapter::storage( *string );
+						else
+						if( key == "size" )
+							m_attr.tupleSize = int(intValue);
+						else
+						if( key == "pagesize" )
+							m_attr.pageSize = int(intValue);
+						break;
+					default:
+						break;
+					};
+				}
+
+				// elements of packing and constant page flag arrays are not key/value pairs
+				if( frame.type == FRAME_PACKING )
+					m_attr.packing.push_back( int(intValue) );
+				else
+				if( frame.type == FRAME_CONSTANT_PACK_FLAGS )
+					m_attr.constantPageFlags.back().push_back( boolValue );
+			}
+
+			// uniform arrays ---
+
+			// where the uniform array which is about to be read belongs to
+			enum UniformArrayTarget
+			{
+				UA_SKIP,
+				UA_PACKING,
+				UA_CONSTANT_PACK_FLAGS,
+				UA_RAWPAGEDATA
+			};
+
+			UniformArrayTarget uniformArrayTarget()const
+			{
+				if( m_frames.empty() )
+					return UA_SKIP;
+				const StreamFrame &frame = m_frames.back();
+				if( frame.type == FRAME_CONSTANT_PAGE_FLAGS )
+					return UA_CONSTANT_PACK_FLAGS;
+				if( (frame.type == FRAME_VALUES) && frame.isValue() )
+				{
+					if( frame.key == "packing" )
+						return UA_PACKING;
+					if( (frame.key == "rawpagedata") && (m_attr.type == "numeric") )
+						return UA_RAWPAGEDATA;
+				}
+				return UA_SKIP;
+			}
+
+			void skip( sint64 numBytes, json::Parser *parser )
+			{
+				char buffer[4096];
+				while( numBytes > 0 )
+				{
+					sint64 count = std::min<sint64>( numBytes, sizeof(buffer) );
+					parser->read<char>( buffer, count );
+					numBytes -= count;
+				}
+			}
+
+			template<typename T>
+			void uniformArray( sint64 numElements, json::Parser *parser )
+			{
+				switch( uniformArrayTarget() )
+				{
+				case UA_PACKING:
+					for( sint64 i=0;i<numElements;++i )
+						m_attr.packing.push_back( int(parser->read<T>()) );
+					break;
+				case UA_RAWPAGEDATA:
+					streamPages<T>( numElements, parser );
+					break;
+				default:
+					skip( numElements*sizeof(T), parser );
+					break;
+				};
+				nextElement();
+			}
+
+			// reads rawpagedata one page at a time, unpacks it into interleaved tuples and hands it to the handler
+			template<typename T>
+			void streamPages( sint64 numComponents, json::Parser *parser )
+			{
+				sint64 numElements = m_attr.owner == HouGeoStream::OWNER_POINT ? m_pointCount : m_vertexCount;
+				int tupleSize = m_attr.tupleSize;
+				bool valid = (m_attr.pageSize > 0) && (tupleSize > 0) &&
+				             (HouGeoAdapter::AttributeAdapter::storageSize( m_attr.storage ) == sizeof(T));
+				if( !valid || !m_handler->attribute( m_attr.name, m_attr.owner, m_attr.storage, tupleSize ) )
+				{
+					skip( numComponents*sizeof(T), parser );
+					return;
+				}
+
+				std::vector<int> packing = m_attr.packing;
+				if( packing.empty() )
+					packing.push_back( tupleSize );
+
+				sint64 pageSize = m_attr.pageSize;
+				std::vector<T> pack( pageSize*tupleSize );
+				std::vector<T> page( pageSize*tupleSize );
+
+				HouGeoStream::Block block;
+				block.name = m_attr.name;
+				block.owner = m_attr.owner;
+				block.storage = m_attr.storage;
+				block.tupleSize = tupleSize;
+				block.data = page.data();
+
+				sint64 componentsRemaining = numComponents;
+				sint64 pageIndex = 0;
+				for( sint64 firstElement=0;firstElement<numElements;firstElement+=pageSize, ++pageIndex )
+				{
+					sint64 numPageElements = std::min( numElements-firstElement, pageSize );
+					int startComponent = 0;
+					for( size_t packIndex=0;packIndex<packing.size();++packIndex )
+					{
+						int packSize = packing[packIndex];
+						bool isConstant = (packIndex < m_attr.constantPageFlags.size()) &&
+						                  (pageIndex < sint64(m_attr.constantPageFlags[packIndex].size())) &&
+						                  m_attr.constantPageFlags[packIndex][pageIndex];
+
+						// constant packs only store the values of a single element
+						sint64 numPackComponents = isConstant ? packSize : numPageElements*packSize;
+						if( numPackComponents > componentsRemaining )
+							throw std::runtime_error( "HouGeoStream: rawpagedata of attribute " + m_attr.name + " is too short" );
+						if( sint64(pack.size()) < numPackComponents )
+							pack.resize( numPackComponents );
+						parser->read<T>( pack.data(), numPackComponents );
+						componentsRemaining -= numPackComponents;
+
+						int numComponents = std::min( packSize, std::max( 0, tupleSize-startComponent ) );
+						for( sint64 i=0;i<numPageElements;++i )
+						{
+							const T *src = &pack[isConstant ? 0 : i*packSize];
+							T *dst = &page[i*tupleSize + startComponent];
+							for( int c=0;c<numComponents;++c )
+								dst[c] = src[c];
+						}
+						startComponent += packSize;
+					}
+
+					block.firstElement = firstElement;
+					block.numElements = numPageElements;
+					m_handler->block( block );
+				}
+
+				skip( componentsRemaining*sizeof(T), parser );
+			}
+
+			virtual void uaBool( sint64 numElements, json::Parser *parser )override
+			{
+				// bool uniform arrays are bitstreams (32 bits per word, lsb first)
+				sint64 numWords = (numElements+31)/32;
+				if( uniformArrayTarget() == UA_CONSTANT_PACK_FLAGS )
+				{
+					std::vector<bool> flags( numElements );
+					for( sint64 w=0;w<numWords;++w )
+					{
+						uint32 word = parser->read<uint32>();
+						for( sint64 i=w*32;i<std::min( numElements, (w+1)*32 );++i )
+							flags[i] = (word & (1u << (i & 31))) != 0;
+					}
+					m_attr.constantPageFlags.push_back( flags );
+				}else
+					skip( numWords*sizeof(uint32), parser );
+				nextElement();
+			}
+			virtual void uaReal16( sint64 numElements, json::Parser *parser )override{uniformArray<real16>( numElements, parser );}
+			virtual void uaReal32( sint64 numElements, json::Parser *parser )override{uniformArray<real32>( numElements, parser );}
+			virtual void uaReal64( sint64 numElements, json::Parser *parser )override{uniformArray<real64>( numElements, parser );}
+			virtual void uaInt8( sint64 numElements, json::Parser *parser )override{uniformArray<sbyte>( numElements, parser );}
+			virtual void uaInt16( sint64 numElements, json::Parser *parser )override{uniformArray<sword>( numElements, parser );}
+			virtual void uaInt32( sint64 numElements, json::Parser *parser )override{uniformArray<sint32>( numElements, parser );}
+			virtual void uaInt64( sint64 numElements, json::Parser *parser )override{uniformArray<sint64>( numElements, parser );}
+			virtual void uaUInt8( sint64 numElements, json::Parser *parser )override{uniformArray<ubyte>( numElements, parser );}
+			virtual void uaUInt16( sint64 numElements, json::Parser *parser )override{uniformArray<uword>( numElements, parser );}
+			virtual void uaString( sint64 numElements, json::Parser *parser )override
+			{
+				for( sint64 i=0;i<numElements;++i )
+					parser->readBinaryString();
+				nextElement();
+			}
+
+			HouGeoStream::Handler                     *m_handler;
+			HouGeoStream::Owner                        m_owner;
+			AttributeState                             m_attr;
+			sint64                                     m_pointCount;
+			sint64                                     m_vertexCount;
+			sint64                                     m_primitiveCount;
+			bool                                       m_countsReported;
+		};
+
+		// forwards blocks to a callback
+		struct CallbackHandler : public HouGeoStream::Handler
+		{
+			CallbackHandler( HouGeoStream::BlockCallback callback ) : m_callback(callback)
+			{
+			}
+
+			virtual void block( const HouGeoStream::Block &block )override
+			{
+				m_callback( block );
+			}
+
+			HouGeoStream::BlockCallback                m_callback;
+		};
+	}
+
+	HouGeoStream::Handler::~Handler()
+	{
+	}
+
+	void HouGeoStream::Handler::counts( sint64, sint64, sint64 )
+	{
+	}
+
+	bool HouGeoStream::Handler::attribute( const std::string &, Owner, Storage, int )
+	{
+		return true;
+	}
+
+	bool HouGeoStream::read( std::istream *in, Handler *handler )
+	{
+		StreamHandler streamHandler( handler );
+		json::Parser p;
+		if( !p.parse( in, &streamHandler ) )
+		{
+			std::cout << "HouGeoStream::read: failed to parse stream\n";
+			return false;
+		}
+		streamHandler.reportCounts();
+		return true;
+	}
+
+	bool HouGeoStream::read( const std::string &path, Handler *handler )
+	{
+		std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+		return read( &in, handler );
+	}
+
+	bool HouGeoStream::read( const std::string &path, BlockCallback callback )
+	{
+		CallbackHandler handler( callback );
+		return read( path, &handler );
+	}
+}
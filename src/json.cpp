@@ -2,7 +2,17 @@
 
 #include <houio/json.h>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 
 
@@ -45,7 +55,7 @@ namespace houio
 			else if (type == JID_INT32)
 				p->handler->jsonInt32( ttl::var::get<sint32>( value ) );
 			else if (type == JID_INT64)
-				p->handler->jsonInt32( (int)ttl::var::get<sint64>( value ) );
+				p->handler->jsonInt64( ttl::var::get<sint64>( value ) );
 			else if (type == JID_REAL32)
 				p->handler->jsonReal32( ttl::var::get<real32>( value ) );
 			else if (type == JID_REAL64)
@@ -60,12 +70,15 @@ namespace houio
 				switch( uaType )
 				{
 				case Token::JID_BOOL:p->handler->uaBool( numElements, p );break;
+				case Token::JID_INT8:p->handler->uaInt8( numElements, p );break;
 				case Token::JID_INT16:p->handler->uaInt16( numElements, p );break;
 				case Token::JID_INT32:p->handler->uaInt32( numElements, p );break;
 				case Token::JID_INT64:p->handler->uaInt64( numElements, p );break;
+				case Token::JID_REAL16:p->handler->uaReal16( numElements, p );break;
 				case Token::JID_REAL32:p->handler->uaReal32( numElements, p );break;
 				case Token::JID_REAL64:p->handler->uaReal64( numElements, p );break;
 				case Token::JID_UINT8:p->handler->uaUInt8( numElements, p );break;
+				case Token::JID_UINT16:p->handler->uaUInt16( numElements, p );break;
 				case Token::JID_STRING:p->handler->uaString( numElements, p );break;
 				case Token::JID_NULL:
 				case Token::JID_MAP_BEGIN:
@@ -81,9 +94,6 @@ namespace houio
 				case Token::JID_KEY_SEPARATOR:
 				case Token::JID_VALUE_SEPARATOR:
 				case Token::JID_MAGIC:
-				case Token::JID_INT8:
-				case Token::JID_REAL16:
-				case Token::JID_UINT16:
 				default:
 					{
 						throw std::runtime_error( "json.cpp Token::event: error unsupported uniform array type" );
@@ -101,6 +111,52 @@ namespace houio
 
 
 
+		// Handler ==================================================
+
+		namespace
+		{
+			// reads a uniform array of S, widens it to T and hands it to the given handler method
+			template<typename S, typename T>
+			void widenUniformArray( sint64 numElements, Parser *parser, Handler *handler, void (Handler::*method)( sint64, Parser * ) )
+			{
+				std::vector<S> src(numElements);
+				if( numElements > 0 )
+					parser->read<S>( &src[0], numElements );
+				std::vector<T> dst( src.begin(), src.end() );
+
+				MemoryBuffer buffer( (char *)dst.data(), dst.size()*sizeof(T) );
+				std::istream in( &buffer );
+				Parser widened;
+				widened.state = parser->state;
+				widened.handler = handler;
+				widened.stream = &in;
+				widened.binary = parser->binary;
+				(handler->*method)( numElements, &widened );
+			}
+		}
+
+		void Handler::jsonInt64( const sint64 &value )
+		{
+			jsonInt32( sint32(value) );
+		}
+
+		void Handler::uaReal16( sint64 numElements, Parser *parser )
+		{
+			widenUniformArray<real16, real32>( numElements, parser, this, &Handler::uaReal32 );
+		}
+
+		void Handler::uaInt8( sint64 numElements, Parser *parser )
+		{
+			widenUniformArray<sbyte, sint32>( numElements, parser, this, &Handler::uaInt32 );
+		}
+
+		void Handler::uaUInt16( sint64 numElements, Parser *parser )
+		{
+			widenUniformArray<uword, sint32>( numElements, parser, this, &Handler::uaInt32 );
+		}
+
+
+
 		// Parser ==================================================
 
 		bool Parser::parse( std::istream *in,  Handler *h )
@@ -124,6 +180,20 @@ namespace houio
 			return true;
 		}
 
+		bool Parser::parseValue( std::istream *in, Handler *h )
+		{
+			if( !in->good() )
+				return false;
+
+			state = STATE_START;
+			stateStack = std::stack<State>();
+			binary = true;
+			handler = h;
+			stream = in;
+
+			return parseStream();
+		}
+
 		bool Parser::parseStream()
 		{
 			Token t;
@@ -251,7 +321,7 @@ namespace houio
 			return true;
 		}
 
-		bool Parser::readBinaryToken( Token &t, ubyte test )
+		bool Parser::readBinaryToken( Token &t, ubyte )
 		{
 			while( (t.type == Token::JID_TOKENDEF) || (t.type == Token::JID_TOKENUNDEF) )
 			{
@@ -286,6 +356,13 @@ namespace houio
 			case Token::JID_INT16: t.value = read<sword>();return true;
 			case Token::JID_INT32: t.value = read<sint32>();return true;
 			case Token::JID_INT64: t.value = read<sint64>();return true;
+			case Token::JID_REAL16:
+				{
+					real16 value;
+					value.setBits( read<uword>() );
+					t.value = real32(value);
+					t.type = Token::JID_REAL32;
+				}return true;
 			case Token::JID_REAL32: t.value = read<real32>();return true;
 			case Token::JID_REAL64: t.value = read<real64>();return true;
 			case Token::JID_UINT8: t.value = read<ubyte>();return true;
@@ -469,6 +546,7 @@ namespace houio
 			sint64 l = readLength();
 			std::string s = readBinaryString();
 			strings[l]  = s;
+			handler->stringDefinition( l, s );
 			return true;
 		}
 
@@ -558,8 +636,10 @@ namespace houio
 					{
 						throw std::runtime_error( "error " );
 					}else
+					{
 						result.push_back('\\');
 						result.push_back(c);
+					}
 				}else
 				if( c == '"' )
 				{
@@ -619,15 +699,279 @@ namespace houio
 
 
 
+		// OutputSink ==================================================
+
+		OutputSink::OutputSink() :
+			m_begin(0),
+			m_cur(0),
+			m_end(0),
+			m_base(0)
+		{
+		}
+
+		StreamSink::StreamSink( std::ostream *out, sint64 bufferSize ) :
+			OutputSink(),
+			m_out(out),
+			m_buffer( size_t(std::max<sint64>( bufferSize, 1 )) )
+		{
+			m_begin = m_cur = &m_buffer[0];
+			m_end = m_begin + m_buffer.size();
+		}
+
+		StreamSink::~StreamSink()
+		{
+			flush();
+		}
+
+		bool StreamSink::flush()
+		{
+			if( m_cur != m_begin )
+				m_out->write( m_begin, m_cur - m_begin );
+			m_base += m_cur - m_begin;
+			m_cur = m_begin;
+			return m_out->good();
+		}
+
+		bool StreamSink::overflow( const char *data, sint64 size )
+		{
+			if( !flush() )
+				return false;
+			if( size >= sint64(m_buffer.size()) )
+			{
+				// large blocks go straight to the stream
+				m_out->write( data, size );
+				m_base += size;
+				return m_out->good();
+			}
+			memcpy( m_cur, data, size_t(size) );
+			m_cur += size;
+			return true;
+		}
+
+		FileSink::FileSink( const std::string &path, sint64 bufferSize, bool useMmap, sint64 preallocate ) :
+			OutputSink(),
+			m_fd(-1),
+			m_file(0),
+			m_useMmap(useMmap),
+			m_mapping(0),
+			m_mappingSize(0),
+			m_failed(false)
+		{
+#ifndef _WIN32
+			m_fd = ::open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666 );
+			if( m_fd < 0 )
+			{
+				std::cout << "FileSink: unable to open " << path << std::endl;
+				m_failed = true;
+				return;
+			}
+#if defined(__linux__)
+			if( preallocate > 0 )
+				posix_fallocate( m_fd, 0, preallocate );
+#endif
+			if( m_useMmap )
+			{
+				if( map( std::max<sint64>( preallocate, 1 << 20 ) ) )
+					return;
+				// fall back to buffered writes
+				m_useMmap = false;
+			}
+#else
+			m_useMmap = false;
+			m_file = std::fopen( path.c_str(), "wb" );
+			if( !m_file )
+			{
+				std::cout << "FileSink: unable to open " << path << std::endl;
+				m_failed = true;
+				return;
+			}
+#endif
+			m_buffer.resize( size_t(std::max<sint64>( bufferSize, 1 )) );
+			m_begin = m_cur = &m_buffer[0];
+			m_end = m_begin + m_buffer.size();
+		}
+
+		FileSink::~FileSink()
+		{
+			close();
+		}
+
+		bool FileSink::isOpen()const
+		{
+			return (m_fd >= 0)||(m_file != 0);
+		}
+
+		bool FileSink::close()
+		{
+			if( !isOpen() )
+				return !m_failed;
+			flush();
+#ifndef _WIN32
+			sint64 size = tell();
+			if( m_mapping )
+				munmap( m_mapping, size_t(m_mappingSize) );
+			m_mapping = 0;
+			// drops preallocated space and the unused part of the mapping
+			if( ftruncate( m_fd, off_t(size) ) != 0 )
+				m_failed = true;
+			if( ::close( m_fd ) != 0 )
+				m_failed = true;
+			m_fd = -1;
+#else
+			if( std::fclose( m_file ) != 0 )
+				m_failed = true;
+			m_file = 0;
+#endif
+			m_begin = m_cur = m_end = 0;
+			return !m_failed;
+		}
+
+		bool FileSink::flush()
+		{
+			if( m_useMmap || !isOpen() )
+				return !m_failed;
+			bool result = writeDevice( m_begin, m_cur - m_begin, 0, 0 );
+			m_base += m_cur - m_begin;
+			m_cur = m_begin;
+			return result;
+		}
+
+		bool FileSink::overflow( const char *data, sint64 size )
+		{
+			if( !isOpen() )
+				return false;
+
+			if( m_useMmap )
+			{
+				// data is copied straight into the mapping
+				sint64 required = tell() + size;
+				sint64 mappingSize = m_mappingSize;
+				while( mappingSize < required )
+					mappingSize *= 2;
+				if( !map( mappingSize ) )
+				{
+					m_failed = true;
+					return false;
+				}
+				memcpy( m_cur, data, size_t(size) );
+				m_cur += size;
+				return true;
+			}
+
+			sint64 buffered = m_cur - m_begin;
+			if( size >= sint64(m_buffer.size()) )
+			{
+				// buffered bytes and the block go out in one gathered write
+				bool result = writeDevice( m_begin, buffered, data, size );
+				m_base += buffered + size;
+				m_cur = m_begin;
+				return result;
+			}
+			bool result = writeDevice( m_begin, buffered, 0, 0 );
+			m_base += buffered;
+			memcpy( m_begin, data, size_t(size) );
+			m_cur = m_begin + size;
+			return result;
+		}
+
+		bool FileSink::writeDevice( const char *buffered, sint64 bufferedSize, const char *data, sint64 size )
+		{
+			if( m_failed )
+				return false;
+#ifndef _WIN32
+			struct iovec blocks[2];
+			blocks[0].iov_base = (void *)buffered;
+			blocks[0].iov_len = size_t(bufferedSize);
+			blocks[1].iov_base = (void *)data;
+			blocks[1].iov_len = size_t(size);
+			int first = bufferedSize > 0 ? 0 : 1;
+			int numBlocks = size > 0 ? 2 : 1;
+			while( first < numBlocks )
+			{
+				ssize_t written = ::writev( m_fd, &blocks[first], numBlocks-first );
+				if( written < 0 )
+				{
+					std::cout << "FileSink: write failed" << std::endl;
+					m_failed = true;
+					return false;
+				}
+				// partial writes continue where they stopped
+				while( (first < numBlocks)&&(size_t(written) >= blocks[first].iov_len) )
+					written -= blocks[first++].iov_len;
+				if( first < numBlocks )
+				{
+					blocks[first].iov_base = (char *)blocks[first].iov_base + written;
+					blocks[first].iov_len -= size_t(written);
+				}
+			}
+#else
+			if( (bufferedSize > 0)&&(std::fwrite( buffered, 1, size_t(bufferedSize), m_file ) != size_t(bufferedSize)) )
+				m_failed = true;
+			if( (size > 0)&&(std::fwrite( data, 1, size_t(size), m_file ) != size_t(size)) )
+				m_failed = true;
+#endif
+			return !m_failed;
+		}
+
+		bool FileSink::map( sint64 size )
+		{
+#ifndef _WIN32
+			sint64 position = tell();
+			if( m_mapping )
+				munmap( m_mapping, size_t(m_mappingSize) );
+			m_mapping = 0;
+			if( ftruncate( m_fd, off_t(size) ) != 0 )
+				return false;
+			void *mapping = mmap( 0, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0 );
+			if( mapping == MAP_FAILED )
+				return false;
+			m_mapping = (char *)mapping;
+			m_mappingSize = size;
+			m_base = 0;
+			m_begin = m_mapping;
+			m_cur = m_mapping + position;
+			m_end = m_mapping + size;
+			return true;
+#else
+			return false;
+#endif
+		}
+
+
 		// Writer ==================================================
 
+		BinaryWriter::BinaryWriter( std::ostream *out ) :
+			m_ownedSink( new StreamSink( out ) ),
+			m_internStrings(false),
+			m_numStringIds(0)
+		{
+			sink = m_ownedSink.get();
+			jsonMagic();
+		}
 
-		BinaryWriter::BinaryWriter( std::ostream *out )
+		BinaryWriter::BinaryWriter( OutputSink *_sink ) :
+			sink(_sink),
+			m_internStrings(false),
+			m_numStringIds(0)
 		{
-			stream = out;
 			jsonMagic();
 		}
 
+		BinaryWriter::~BinaryWriter()
+		{
+			sink->flush();
+		}
+
+		bool BinaryWriter::flush()
+		{
+			return sink->flush();
+		}
+
+		void BinaryWriter::setStringInterning( bool intern )
+		{
+			m_internStrings = intern;
+		}
+
 		bool BinaryWriter::writeId( Token::Type id )
 		{
 			return write<ubyte>( (ubyte)id );
@@ -680,6 +1024,28 @@ namespace houio
 
 		void BinaryWriter::jsonString( const std::string &value )
 		{
+			if( m_internStrings && (value.size() <= maxInternedLength) )
+			{
+				auto it = m_stringIds.find( value );
+				if( it != m_stringIds.end() )
+				{
+					// the string is defined on its second occurence, so strings which appear only once dont pay for the definition
+					if( it->second < 0 )
+					{
+						it->second = m_numStringIds++;
+						writeId( Token::JID_TOKENDEF );
+						writeLength( it->second );
+						writeLength( value.size() );
+						write<sbyte>( (const sbyte *)&value[0], (sint64)value.size() );
+					}
+					writeId( Token::JID_TOKENREF );
+					writeLength( it->second );
+					return;
+				}
+				if( m_stringIds.size() < maxInternedStrings )
+					m_stringIds[value] = -1;
+			}
+
 			writeId( Token::JID_STRING );
 			writeLength( value.size() );
 			write<sbyte>( (const sbyte *)&value[0], (sint64)value.size() );
@@ -747,6 +1113,21 @@ namespace houio
 			write<real64>(value );
 		}
 
+		bool BinaryWriter::jsonBeginUniformArray( Token::Type type, sint64 numElements )
+		{
+			writeId( Token::JID_UNIFORM_ARRAY );
+			write<sbyte>( (sbyte)type );
+			return writeLength( numElements );
+		}
+
+		bool BinaryWriter::jsonUniformBoolArray( const uint32 *bits, sint64 numElements )
+		{
+			jsonBeginUniformArray( Token::JID_BOOL, numElements );
+			if( numElements > 0 )
+				write<uint32>( bits, (numElements+31)/32 );
+			return true;
+		}
+
 		void BinaryWriter::jsonBool( const bool &value )
 		{
 			if( value )
@@ -757,19 +1138,380 @@ namespace houio
 
 
 
+		// number formatting ========================================
+		namespace
+		{
+			const char digitPairs[] =
+				"00010203040506070809"
+				"10111213141516171819"
+				"20212223242526272829"
+				"30313233343536373839"
+				"40414243444546474849"
+				"50515253545556575859"
+				"60616263646566676869"
+				"70717273747576777879"
+				"80818283848586878889"
+				"90919293949596979899";
+
+			const uint32 pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+			// normalized 64bit approximations of 10^k for k=-348,-340,...,340 (significand and binary exponent)
+			const uint64 cachedPowersF[] =
+			{
+				0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull, 0xcf42894a5dce35eaull,
+				0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull, 0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full,
+				0xbe5691ef416bd60cull, 0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+				0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull, 0xc21094364dfb5637ull,
+				0x9096ea6f3848984full, 0xd77485cb25823ac7ull, 0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull,
+				0xb23867fb2a35b28eull, 0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+				0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull, 0xb5b5ada8aaff80b8ull,
+				0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull, 0x964e858c91ba2655ull, 0xdff9772470297ebdull,
+				0xa6dfbd9fb8e5b88full, 0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+				0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull, 0xaa242499697392d3ull,
+				0xfd87b5f28300ca0eull, 0xbce5086492111aebull, 0x8cbccc096f5088ccull, 0xd1b71758e219652cull,
+				0x9c40000000000000ull, 0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+				0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull, 0x9f4f2726179a2245ull,
+				0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull, 0x83c7088e1aab65dbull, 0xc45d1df942711d9aull,
+				0x924d692ca61be758ull, 0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+				0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull, 0x952ab45cfa97a0b3ull,
+				0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull, 0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull,
+				0x88fcf317f22241e2ull, 0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+				0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull, 0x8bab8eefb6409c1aull,
+				0xd01fef10a657842cull, 0x9b10a4e5e9913129ull, 0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull,
+				0x80444b5e7aa7cf85ull, 0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+				0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+			};
+			const sint16 cachedPowersE[] =
+			{
+				-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007,  -980,
+				 -954,  -927,  -901,  -874,  -847,  -821,  -794,  -768,  -741,  -715,
+				 -688,  -661,  -635,  -608,  -582,  -555,  -529,  -502,  -475,  -449,
+				 -422,  -396,  -369,  -343,  -316,  -289,  -263,  -236,  -210,  -183,
+				 -157,  -130,  -103,   -77,   -50,   -24,     3,    30,    56,    83,
+				  109,   136,   162,   189,   216,   242,   269,   295,   322,   348,
+				  375,   402,   428,   455,   481,   508,   534,   561,   588,   614,
+				  641,   667,   694,   720,   747,   774,   800,   827,   853,   880,
+				  907,   933,   960,   986,  1013,  1039,  1066
+			};
+
+			// floating point number f*2^e with a 64bit significand
+			struct DiyFp
+			{
+				DiyFp() : f(0), e(0){}
+				DiyFp( uint64 _f, int _e ) : f(_f), e(_e){}
+
+				// upper 64 bits of the 128bit product (rounded)
+				DiyFp operator*( const DiyFp &rhs )const
+				{
+					const uint64 mask = 0xffffffffu;
+					uint64 a = f >> 32, b = f & mask, c = rhs.f >> 32, d = rhs.f & mask;
+					uint64 ac = a*c, bc = b*c, ad = a*d, bd = b*d;
+					uint64 tmp = (bd >> 32) + (ad & mask) + (bc & mask) + (uint64(1) << 31);
+					return DiyFp( ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + rhs.e + 64 );
+				}
+
+				DiyFp normalize()const
+				{
+#if defined(__GNUC__)
+					int shift = __builtin_clzll( f );
+					return DiyFp( f << shift, e - shift );
+#else
+					DiyFp r = *this;
+					while( !(r.f & (uint64(1) << 63)) )
+					{
+						r.f <<= 1;
+						--r.e;
+					}
+					return r;
+#endif
+				}
+
+				uint64                                f;
+				int                                   e;
+			};
+
+			// splits a positive finite value into its normalized significand and the boundaries to its neighbours
+			// exponentBias includes the significand size (e.g. 1075 for doubles)
+			template<typename T, typename Bits, int significandSize, int exponentBias>
+			DiyFp decompose( T value, DiyFp &minus, DiyFp &plus )
+			{
+				Bits bits;
+				memcpy( &bits, &value, sizeof(T) );
+				const Bits hidden = Bits(1) << significandSize;
+				int biasedExponent = int( bits >> significandSize );
+				DiyFp v;
+				if( biasedExponent != 0 )
+					v = DiyFp( uint64((bits & (hidden - 1)) + hidden), biasedExponent - exponentBias );
+				else
+					v = DiyFp( uint64(bits & (hidden - 1)), 1 - exponentBias );
+
+				plus = DiyFp( (v.f << 1) + 1, v.e - 1 ).normalize();
+				// the gap to the lower neighbour is only half as big at powers of two
+				if( (v.f == uint64(hidden))&&(biasedExponent > 1) )
+					minus = DiyFp( (v.f << 2) - 1, v.e - 2 );
+				else
+					minus = DiyFp( (v.f << 1) - 1, v.e - 1 );
+				minus.f <<= minus.e - plus.e;
+				minus.e = plus.e;
+				return v.normalize();
+			}
+
+			// cached power c=10^-K such that the exponent of c*2^e lies within [-60, -32]
+			DiyFp cachedPower( int e, int &K )
+			{
+				double dk = (-61 - e) * 0.30102999566398114 + 347;
+				int k = int(dk);
+				if( dk - k > 0.0 )
+					++k;
+				int index = (k >> 3) + 1;
+				K = -(-348 + index * 8);
+				return DiyFp( cachedPowersF[index], cachedPowersE[index] );
+			}
+
+			int countDigits( uint32 n )
+			{
+				int count = 1;
+				while( (count < 10)&&(n >= pow10[count]) )
+					++count;
+				return count;
+			}
+
+			// moves the last digit towards the exact value as long as it stays within the rounding interval
+			void grisuRound( char *buffer, int length, uint64 delta, uint64 rest, uint64 tenKappa, uint64 distance )
+			{
+				while( (rest < distance)&&(delta - rest >= tenKappa)&&
+					   ((rest + tenKappa < distance)||(distance - rest > rest + tenKappa - distance)) )
+				{
+					--buffer[length - 1];
+					rest += tenKappa;
+				}
+			}
+
+			// generates the shortest digit sequence within (mp-delta, mp)
+			void digitGen( const DiyFp &w, const DiyFp &mp, uint64 delta, char *buffer, int &length, int &K )
+			{
+				const DiyFp one( uint64(1) << -mp.e, mp.e );
+				const uint64 distance = mp.f - w.f;
+				uint32 p1 = uint32( mp.f >> -one.e );
+				uint64 p2 = mp.f & (one.f - 1);
+				int kappa = countDigits( p1 );
+				length = 0;
+
+				while( kappa > 0 )
+				{
+					uint32 d = p1 / pow10[kappa - 1];
+					p1 %= pow10[kappa - 1];
+					if( d || length )
+						buffer[length++] = char( '0' + d );
+					--kappa;
+					uint64 rest = (uint64(p1) << -one.e) + p2;
+					if( rest <= delta )
+					{
+						K += kappa;
+						grisuRound( buffer, length, delta, rest, uint64(pow10[kappa]) << -one.e, distance );
+						return;
+					}
+				}
+
+				while( true )
+				{
+					p2 *= 10;
+					delta *= 10;
+					char d = char( p2 >> -one.e );
+					if( d || length )
+						buffer[length++] = char( '0' + d );
+					p2 &= one.f - 1;
+					--kappa;
+					if( p2 < delta )
+					{
+						K += kappa;
+						int index = -kappa;
+						grisuRound( buffer, length, delta, p2, one.f, distance * (index < 10 ? pow10[index] : 0) );
+						return;
+					}
+				}
+			}
+
+			int writeExponent( int K, char *buffer )
+			{
+				char *p = buffer;
+				if( K < 0 )
+				{
+					*p++ = '-';
+					K = -K;
+				}
+				if( K >= 100 )
+				{
+					*p++ = char( '0' + K / 100 );
+					K %= 100;
+					*p++ = digitPairs[K * 2];
+					*p++ = digitPairs[K * 2 + 1];
+				}else
+				if( K >= 10 )
+				{
+					*p++ = digitPairs[K * 2];
+					*p++ = digitPairs[K * 2 + 1];
+				}else
+					*p++ = char( '0' + K );
+				return int(p - buffer);
+			}
+
+			// turns digits*10^k into decimal or exponential notation
+			int prettify( char *buffer, int length, int k )
+			{
+				const int kk = length + k; // 10^(kk-1) <= v < 10^kk
+				if( (k >= 0)&&(kk <= 21) )
+				{
+					// 1234e7 -> 12340000000.0
+					for( int i=length;i<kk;++i )
+						buffer[i] = '0';
+					buffer[kk] = '.';
+					buffer[kk + 1] = '0';
+					return kk + 2;
+				}else
+				if( (kk > 0)&&(kk <= 21) )
+				{
+					// 1234e-2 -> 12.34
+					memmove( &buffer[kk + 1], &buffer[kk], size_t(length - kk) );
+					buffer[kk] = '.';
+					return length + 1;
+				}else
+				if( (kk > -6)&&(kk <= 0) )
+				{
+					// 1234e-6 -> 0.001234
+					const int offset = 2 - kk;
+					memmove( &buffer[offset], &buffer[0], size_t(length) );
+					buffer[0] = '0';
+					buffer[1] = '.';
+					for( int i=2;i<offset;++i )
+						buffer[i] = '0';
+					return length + offset;
+				}else
+				if( length == 1 )
+				{
+					// 1e30
+					buffer[1] = 'e';
+					return 2 + writeExponent( kk - 1, &buffer[2] );
+				}
+				// 1234e30 -> 1.234e33
+				memmove( &buffer[2], &buffer[1], size_t(length - 1) );
+				buffer[1] = '.';
+				buffer[length + 1] = 'e';
+				return length + 2 + writeExponent( kk - 1, &buffer[length + 2] );
+			}
+
+			template<typename T, typename Bits, int significandSize, int exponentBias>
+			int formatFloatingPoint( T value, char *buffer )
+			{
+				char *p = buffer;
+				if( value != value )
+				{
+					memcpy( p, "nan", 3 );
+					return 3;
+				}
+				if( std::signbit( value ) )
+				{
+					*p++ = '-';
+					value = -value;
+				}
+				if( value == std::numeric_limits<T>::infinity() )
+				{
+					memcpy( p, "inf", 3 );
+					return int(p - buffer) + 3;
+				}
+				if( value == T(0) )
+				{
+					memcpy( p, "0.0", 3 );
+					return int(p - buffer) + 3;
+				}
+
+				DiyFp minus, plus;
+				DiyFp w = decompose<T, Bits, significandSize, exponentBias>( value, minus, plus );
+				int K = 0;
+				DiyFp c = cachedPower( plus.e, K );
+				DiyFp W = w * c;
+				DiyFp Wp = plus * c;
+				DiyFp Wm = minus * c;
+				// account for the imprecision of the cached power
+				++Wm.f;
+				--Wp.f;
+				int length = 0;
+				digitGen( W, Wp, Wp.f - Wm.f, p, length, K );
+				return int(p - buffer) + prettify( p, length, K );
+			}
+		}
+
+		int formatInt( sint64 value, char *buffer )
+		{
+			char *p = buffer;
+			uint64 u = uint64(value);
+			if( value < 0 )
+			{
+				*p++ = '-';
+				u = uint64(0) - u;
+			}
+
+			// digits are generated backwards, two at a time
+			char temp[20];
+			char *t = temp + 20;
+			while( u >= 100 )
+			{
+				const char *d = &digitPairs[(u % 100) * 2];
+				u /= 100;
+				*--t = d[1];
+				*--t = d[0];
+			}
+			if( u >= 10 )
+			{
+				*--t = digitPairs[u * 2 + 1];
+				*--t = digitPairs[u * 2];
+			}else
+				*--t = char( '0' + u );
+
+			int length = int(temp + 20 - t);
+			memcpy( p, t, length );
+			return int(p - buffer) + length;
+		}
+
+		int formatReal( real32 value, char *buffer )
+		{
+			return formatFloatingPoint<real32, uint32, 23, 150>( value, buffer );
+		}
+
+		int formatReal( real64 value, char *buffer )
+		{
+			return formatFloatingPoint<real64, uint64, 52, 1075>( value, buffer );
+		}
+
+
+
 		// ASCIIWriter =============================================
 
-		ASCIIWriter::ASCIIWriter( std::ostream *out )
+		ASCIIWriter::ASCIIWriter( std::ostream *out ) :
+			m_ownedSink( new StreamSink( out ) )
 		{
-			stream = out;
+			sink = m_ownedSink.get();
 			gotKey = false;
 			firstItem = false;
 			indentLevel = 0;
 		}
 
-		void ASCIIWriter::write( const std::string &text )
+		ASCIIWriter::ASCIIWriter( OutputSink *_sink ) :
+			sink(_sink)
+		{
+			gotKey = false;
+			firstItem = false;
+			indentLevel = 0;
+		}
+
+		ASCIIWriter::~ASCIIWriter()
+		{
+			sink->flush();
+		}
+
+		bool ASCIIWriter::flush()
 		{
-			stream->write( text.c_str(), text.size() );
+			return sink->flush();
 		}
 
 		void ASCIIWriter::jsonBeginArray()
@@ -777,7 +1519,7 @@ namespace houio
 			writePrefix();
 			stack.push( Token::JID_ARRAY_BEGIN );
 			writeNewline();
-			write( "[" );
+			write( "[", 1 );
 			++indentLevel;
 			writeNewline();
 			firstItem = true;
@@ -789,7 +1531,7 @@ namespace houio
 			stack.pop();
 			--indentLevel;
 			writeNewline();
-			write( "]" );
+			write( "]", 1 );
 		}
 
 		void ASCIIWriter::jsonBeginMap()
@@ -797,7 +1539,7 @@ namespace houio
 			writePrefix();
 			stack.push( Token::JID_MAP_BEGIN );
 			writeNewline();
-			write( "{" );
+			write( "{", 1 );
 			++indentLevel;
 			writeNewline();
 			firstItem = true;
@@ -809,76 +1551,93 @@ namespace houio
 			stack.pop();
 			--indentLevel;
 			writeNewline();
-			write( "}" );
+			write( "}", 1 );
 		}
 
 		void ASCIIWriter::jsonString( const std::string &value )
 		{
 			writePrefix();
-			write( "\"" + value + "\"" );
+			write( "\"", 1 );
+			write( value );
+			write( "\"", 1 );
 		}
 
 		void ASCIIWriter::jsonKey( const std::string &key )
 		{
 			writePrefix();
-			write( "\"" + key + "\"" );
+			write( "\"", 1 );
+			write( key );
+			write( "\"", 1 );
 			gotKey = true;
 		}
 
 		void ASCIIWriter::jsonInt( const sint64 &value )
 		{
 			writePrefix();
-			write( toString<sint64>(value) );
+			writeNumber<sint64>( value );
 		}
 
 		void ASCIIWriter::jsonUInt8( const ubyte &value )
 		{
 			writePrefix();
-			write( toString<ubyte>(value) );
+			writeNumber<ubyte>( value );
 		}
 
 		void ASCIIWriter::jsonInt8( const sbyte &value )
 		{
 			writePrefix();
-			write( toString<sbyte>(value) );
+			writeNumber<sbyte>( value );
 		}
 
 		void ASCIIWriter::jsonInt32( const sint32 &value )
 		{
 			writePrefix();
-			write( toString<sint32>(value) );
+			writeNumber<sint32>( value );
 		}
 
 		void ASCIIWriter::jsonInt64( const sint64 &value )
 		{
 			writePrefix();
-			write( toString<sint64>(value) );
+			writeNumber<sint64>( value );
 		}
 
 		void ASCIIWriter::jsonReal32( const real32 &value )
 		{
+			// formatReal always emits a point or an exponent, so the value is loaded as float back in
 			writePrefix();
-			std::string str = toString<real32>(value);
-			write( str );
-			// if string is not in scientific notation and doesnt contain a point
-			// we will append one to make sure the value is loaded as float back in
-			if( (str.find( 'e' ) == std::string::npos)&&(str.find( '.' ) == std::string::npos) )
-				write( ".0" );
+			writeNumber<real32>( value );
 		}
 
 		void ASCIIWriter::jsonReal64( const real64 &value )
 		{
 			writePrefix();
-			write( toString<real64>(value) );
+			writeNumber<real64>( value );
 		}
 
 		void ASCIIWriter::jsonBool( const bool &value )
 		{
 			writePrefix();
 			if( value )
-				write( "true" );
+				write( "true", 4 );
 			else
-				write( "false" );
+				write( "false", 5 );
+		}
+
+		bool ASCIIWriter::jsonUniformBoolArray( const uint32 *bits, sint64 numElements )
+		{
+			writePrefix();
+			write( "[", 1 );
+			for( sint64 i=0;i<numElements;++i )
+			{
+				if( i > 0 )
+					write( ", ", 2 );
+				if( bits[i >> 5] & (1u << (i & 31)) )
+					write( "true", 4 );
+				else
+					write( "false", 5 );
+			}
+			write( "]", 1 );
+			return true;
 		}
 
 		void ASCIIWriter::writePrefix()
@@ -890,28 +1649,29 @@ namespace houio
 			if( gotKey )
 			{
 				gotKey = false;
-				write( ":" );
+				write( ":", 1 );
 			}else
 			if( !stack.empty() )
 			{
 				if( (stack.top() == Token::JID_MAP_BEGIN)||
 					(stack.top() == Token::JID_ARRAY_BEGIN))
 				{
-					write( ", " );
+					write( ", ", 2 );
 					writeNewline();
 				}
 				else
 				{
-					write( ", " );
+					write( ", ", 2 );
 				}
 			}
 		}
 
 		void ASCIIWriter::writeNewline()
 		{
-			write( "\n" );
-			for( int i=0;i<indentLevel;++i )
-				write( "\t" );
+			static const char tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+			write( "\n", 1 );
+			for( int i=indentLevel;i>0;i-=16 )
+				write( tabs, std::min( i, 16 ) );
 		}
 
 
@@ -937,9 +1697,11 @@ namespace houio
 				//real64
 				case 3: memcpy( dst, &ttl::var::get<real64>(m_value), sizeof(real64));break;
 				//ubyte
-				case 4: memcpy( dst, &ttl::var::get<ubyte>(m_value), sizeof(ubyte));break;
+				case 5: memcpy( dst, &ttl::var::get<ubyte>(m_value), sizeof(ubyte));break;
 				//sint64
-				case 5: memcpy( dst, &ttl::var::get<sint64>(m_value), sizeof(sint64));break;
+				case 6: memcpy( dst, &ttl::var::get<sint64>(m_value), sizeof(sint64));break;
+				//sbyte
+				case 7: memcpy( dst, &ttl::var::get<sbyte>(m_value), sizeof(sbyte));break;
 			}
 		}
 
@@ -1064,8 +1826,8 @@ namespace houio
 			{
 				switch( m_uniformType )
 				{
-					//bool
-				case 0: return Value::create<bool>( *((bool *)(&m_uniformdata[sizeof(bool)*index])) );break;
+					//bool (packed bitstream)
+				case 0: return Value::create<bool>( (((uint32 *)m_uniformdata)[index >> 5] & (1u << (index & 31))) != 0 );break;
 					//sint32
 				case 1: return Value::create<sint32>( *((sint32 *)(&m_uniformdata[sizeof(sint32)*index])) );break;
 					//real32
@@ -1077,6 +1839,8 @@ namespace houio
 				case 5: return Value::create<ubyte>( *((ubyte *)(&m_uniformdata[sizeof(ubyte)*index])) );break;
 					//sint64
 				case 6: return Value::create<sint64>( *((sint64 *)(&m_uniformdata[sizeof(sint64)*index])) );break;
+					//sbyte
+				case 7: return Value::create<sbyte>( *((sbyte *)(&m_uniformdata[sizeof(sbyte)*index])) );break;
 				}
 			}
 			return m_values[index];
@@ -1245,31 +2009,58 @@ namespace houio
 			jsonValue<sint32>(value);
 		}
 
+		void JSONReader::jsonInt64( const sint64 &value )
+		{
+			if( (value >= std::numeric_limits<sint32>::min())&&(value <= std::numeric_limits<sint32>::max()) )
+				jsonValue<sint32>(sint32(value));
+			else
+				jsonValue<sint64>(value);
+		}
+
 		void JSONReader::jsonReal32( const real32 &value )
 		{
 			jsonValue<real32>(value);
 		}
 
 
+		bool JSONReader::skipPayload( sint64 numBytes, Parser *parser )
+		{
+			if( skippedPayloads.empty() || !skippedPayloads.count( sint64(parser->stream->tellg()) ) )
+				return false;
+			parser->stream->seekg( numBytes, std::ios_base::cur );
+			return true;
+		}
+
 		void JSONReader::uaBool( sint64 numElements, Parser *parser )
 		{
 			//In binary JSON files, uniform bool arrays are stored as bit
-			//streams.  This method decodes the bit-stream, calling jsonBool()
-			//for each element of the bit array.
+			//streams. We keep the bitstream packed (32 bits per word, lsb first)
+			//so that large groups dont get expanded into one value per element.
+			typedef ttl::meta::find_equivalent_type<const bool&, Value::Variant::list> found;
+
+			sint64 numWords = (numElements+31)/32;
+			if( skipPayload( numWords*sizeof(uint32), parser ) )
+				numElements = numWords = 0;
+			Value v = Value::createArray();
+			ArrayPtr ua = v.asArray();
+			ua->m_isUniform = true;
+			ua->m_uniformdata = (unsigned char *)malloc( std::max(numWords, sint64(1))*sizeof(uint32) );
+			ua->m_numUniformElements = numElements;
+			ua->m_uniformType = found::index;
+			if( numWords > 0 )
+				parser->read<uint32>( (uint32 *)ua->m_uniformdata, numWords );
+
+			if( m_root.isArray() )
+				m_root.asArray()->append(v);
+			else
+			if( m_root.isObject() )
+				m_root.asObject()->append(nextKey, v);
 
-			jsonBeginArray();
-			int count = (int) numElements;
-			while( count > 0 )
-			{
-				uint32 bits;
-				parser->read<uint32>( &bits, 1 );
-				int nbits = std::min( count, 32 );
-				count -= nbits;
-				for( int i=0;i<nbits;++i )
-					jsonBool( (bits & (1 << i)) != 0 );
-			}
-			jsonEndArray();
+		}
 
+		void JSONReader::uaReal16( sint64 numElements, Parser *parser )
+		{
+			jsonUA<real32, real16>(numElements, parser);
 		}
 
 		void JSONReader::uaReal32( sint64 numElements, Parser *parser )
@@ -1282,6 +2073,11 @@ namespace houio
 			jsonUA<real64, real64>(numElements, parser);
 		}
 
+		void JSONReader::uaInt8( sint64 numElements, Parser *parser )
+		{
+			jsonUA<sbyte, sbyte>(numElements, parser);
+		}
+
 		void JSONReader::uaInt16( sint64 numElements, Parser *parser )
 		{
 			jsonUA<sint32, sword>(numElements, parser);
@@ -1302,6 +2098,11 @@ namespace houio
 			jsonUA<ubyte, ubyte>(numElements, parser);
 		}
 
+		void JSONReader::uaUInt16( sint64 numElements, Parser *parser )
+		{
+			jsonUA<sint32, uword>(numElements, parser);
+		}
+
 		
 		void JSONReader::uaString( sint64 numElements, Parser *parser )
 		{
@@ -1328,6 +2129,23 @@ namespace houio
 
 		bool JSONWriter::write( ArrayPtr array )
 		{
+			if( array->isUniform() )
+			{
+				sint64 numElements = array->size();
+				switch( array->m_uniformType )
+				{
+				case 0:
+					if( m_binaryWriter )
+						return m_binaryWriter->jsonUniformBoolArray( (const uint32 *)array->m_uniformdata, numElements );
+					return m_asciiWriter->jsonUniformBoolArray( (const uint32 *)array->m_uniformdata, numElements );
+				case 1: return writeUniform<sint32>( (const sint32 *)array->m_uniformdata, numElements );
+				case 2: return writeUniform<real32>( (const real32 *)array->m_uniformdata, numElements );
+				case 3: return writeUniform<real64>( (const real64 *)array->m_uniformdata, numElements );
+				case 5: return writeUniform<ubyte>( (const ubyte *)array->m_uniformdata, numElements );
+				case 6: return writeUniform<sint64>( (const sint64 *)array->m_uniformdata, numElements );
+				case 7: return writeUniform<sbyte>( (const sbyte *)array->m_uniformdata, numElements );
+				}
+			}
 			m_writer->jsonBeginArray();
 			for( std::vector<Value>::iterator it = array->m_values.begin(), end = array->m_values.end(); it != end; ++it )
 				write( *it );
@@ -0,0 +1,936 @@
+#include <houio/HouGeoIO.h>
+#include <houio/HouGeoBatch.h>
+#include <houio/HouGeoExportQueue.h>
+#include <houio/HouGeoSequence.h>
+#include <houio/HouGeoStream.h>
+#include <houio/json.h>
+#include <houio/HouGeo.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+
+// writes files with the features and encodings houio supports, imports them again and compares the result
+// with what has been written (or with what a plain import gives)
+// files are written into the working directory
+
+using namespace houio;
+
+
+// json log of given file, used to check which encoding has been written
+std::string fileLog( const std::string &path )
+{
+	std::ostringstream out;
+	HouGeoIO::makeLog( path, &out );
+	return out.str();
+}
+
+std::string fileContent( const std::string &path )
+{
+	std::ifstream in( path.c_str(), std::ios_base::in | std::ios_base::binary );
+	std::ostringstream out;
+	out << in.rdbuf();
+	return out.str();
+}
+
+bool check( const std::string &name, bool result )
+{
+	std::cout << name << ": " << (result ? "ok" : "FAILED") << std::endl;
+	return result;
+}
+
+// value of given key of a json array which holds alternating keys and values (0 if there is no such key)
+sint64 findKey( json::ArrayPtr keyValues, const std::string &key )
+{
+	for( sint64 i=0;i+1<keyValues->size();i+=2 )
+		if( keyValues->getValue( int(i) ).isString() && (keyValues->get<std::string>( int(i) ) == key) )
+			return i+1;
+	return 0;
+}
+
+// two volumes which reference the same sharedvoxels block share one buffer until one of them is written to
+bool testSharedVoxels()
+{
+	HouGeo::Ptr houGeo = HouGeo::create();
+	for( int i=0;i<2;++i )
+	{
+		ScalarField::Ptr field = std::make_shared<ScalarField>();
+		field->resize( math::V3i( 20, 18, 17 ) );
+		real32 *voxels = field->getRawPointer();
+		for( int j=0;j<20*18*17;++j )
+			voxels[j] = float(j%23) + float(i);
+		houGeo->addPrimitive( field );
+	}
+
+	// the exporter doesnt write shared voxels, the voxels of the first volume are moved into sharedprimitivedata
+	std::stringstream exported;
+	if( !HouGeoIO::xport( &exported, houGeo, false ) )
+		return false;
+	json::JSONReader reader;
+	json::Parser parser;
+	if( !parser.parse( &exported, &reader ) )
+		return false;
+	json::ArrayPtr root = reader.getRoot().asArray();
+	json::ArrayPtr primitives = root->getArray( int(findKey( root, "primitives" )) );
+	json::Value sharedVoxels;
+	for( int i=0;i<2;++i )
+	{
+		json::ArrayPtr volume = primitives->getArray( i )->getArray( 1 );
+		sint64 voxels = findKey( volume, "voxels" );
+		if( !voxels )
+			return false;
+		if( i == 0 )
+			sharedVoxels = volume->m_values[size_t(voxels)];
+		volume->m_values[size_t(voxels-1)] = json::Value::create<std::string>( "sharedvoxels" );
+		volume->m_values[size_t(voxels)] = json::Value::create<std::string>( "block0" );
+	}
+	json::ArrayPtr entry = json::Array::create();
+	entry->appendValue<std::string>( "voxels" );
+	entry->appendValue<std::string>( "block0" );
+	entry->append( sharedVoxels );
+	json::ArrayPtr shared = json::Array::create();
+	shared->appendValue<std::string>( "volume" );
+	shared->append( entry );
+	root->m_values.insert( root->m_values.begin() + findKey( root, "primitives" ) - 1, json::Value::create<std::string>( "sharedprimitivedata" ) );
+	root->m_values.insert( root->m_values.begin() + findKey( root, "sharedprimitivedata" ), json::Value::createArray( shared ) );
+
+	std::stringstream file;
+	{
+		json::JSONWriter writer( &file );
+		writer.write( root );
+	}
+	HouGeo::Ptr result = HouGeoIO::import( &file );
+	std::vector<HouGeoAdapter::Primitive::Ptr> resultPrimitives;
+	if( result )
+		result->getPrimitives( resultPrimitives );
+	if( resultPrimitives.size() != 2 )
+		return false;
+	HouGeo::HouVolume::Ptr first = std::dynamic_pointer_cast<HouGeo::HouVolume>( resultPrimitives[0] );
+	HouGeo::HouVolume::Ptr second = std::dynamic_pointer_cast<HouGeo::HouVolume>( resultPrimitives[1] );
+	if( !first || !second )
+		return false;
+	ScalarField::Ptr firstField = first->getField();
+	ScalarField::Ptr secondField = second->getField();
+	if( (firstField->getData() != secondField->getData()) || !firstField->isShared() )
+		return false;
+	for( int j=0;j<20*18*17;++j )
+		if( static_cast<const ScalarField &>(*secondField).getRawPointer()[j] != float(j%23) )
+			return false;
+
+	// writing detaches the written field only
+	firstField->getRawPointer()[0] = -1.0f;
+	return (firstField->getData() != secondField->getData()) && (static_cast<const ScalarField &>(*secondField).getRawPointer()[0] == 0.0f);
+}
+
+// ramp volume whose voxels are unique, written with raw tiles
+ScalarField::Ptr rampVolume( const math::V3i &res )
+{
+	ScalarField::Ptr field = std::make_shared<ScalarField>();
+	field->resize( res );
+	real32 *voxels = field->getRawPointer();
+	for( sint64 i=0, numVoxels = sint64(res.x)*res.y*res.z;i<numVoxels;++i )
+		voxels[i] = float(i);
+	return field;
+}
+
+// region import gives the voxels of the full import within the region (binary files through the index, ascii files from the document)
+bool testRegionImport()
+{
+	math::V3i res( 40, 35, 20 );
+	HouGeoIO::ExportOptions options;
+	options.constantTiles = false;
+	for( int binary=0;binary<2;++binary )
+	{
+		options.binary = binary != 0;
+		std::string path = binary ? "roundtrip_region.bgeo" : "roundtrip_region.geo";
+		if( !HouGeoIO::xport( path, rampVolume( res ), options ) )
+			return false;
+		ScalarField::Ptr full = HouGeoIO::importVolume( path );
+		ScalarField::Ptr cropped = HouGeoIO::importVolume( path, math::Box3f( 5.2f, 17.0f, 3.0f, 33.0f, 30.5f, 19.0f ), true );
+		if( !full || !cropped )
+			return false;
+		math::V3i croppedRes = cropped->getResolution();
+		if( (croppedRes.x != 28)||(croppedRes.y != 14)||(croppedRes.z != 16) )
+			return false;
+		const real32 *fullVoxels = static_cast<const ScalarField &>(*full).getRawPointer();
+		const real32 *croppedVoxels = static_cast<const ScalarField &>(*cropped).getRawPointer();
+		for( int k=0;k<croppedRes.z;++k )
+			for( int j=0;j<croppedRes.y;++j )
+				for( int i=0;i<croppedRes.x;++i )
+					if( croppedVoxels[(k*croppedRes.y + j)*croppedRes.x + i] != fullVoxels[((k+3)*res.y + j+17)*res.x + i+5] )
+						return false;
+
+		// regions outside of the volume give no field
+		if( HouGeoIO::importVolume( path, math::Box3f( 50.0f, 0.0f, 0.0f, 60.0f, 10.0f, 10.0f ), true ) )
+			return false;
+	}
+	return true;
+}
+
+// volumes are decoded on first access only, concurrent first accesses decode once and see the same field
+bool testLazyDecode()
+{
+	HouGeo::Ptr houGeo = HouGeo::create();
+	houGeo->addPrimitive( rampVolume( math::V3i( 30, 20, 10 ) ) );
+	houGeo->addPrimitive( rampVolume( math::V3i( 12, 14, 16 ) ) );
+	if( !HouGeoIO::xport( "roundtrip_lazy.bgeo", houGeo ) )
+		return false;
+
+	std::vector<HouGeo::HouVolume::Ptr> volumes;
+	HouGeo::Ptr result = HouGeoIO::importVolumes( "roundtrip_lazy.bgeo", volumes );
+	if( !result || (volumes.size() != 2) || volumes[0]->isDecoded() || volumes[1]->isDecoded() )
+		return false;
+	math::V3i res = volumes[1]->getResolution();
+	if( (res.x != 12)||(res.y != 14)||(res.z != 16)||volumes[1]->isDecoded() )
+		return false;
+
+	std::vector<ScalarField::Ptr> fields( 4 );
+	std::vector<std::thread> threads;
+	for( int i=0;i<4;++i )
+		threads.push_back( std::thread( [&, i]
+		{
+			volumes[1]->getResolution();
+			fields[i] = volumes[1]->getField();
+		}));
+	for( auto &thread:threads )
+		thread.join();
+	for( int i=0;i<4;++i )
+		if( fields[i] != fields[0] )
+			return false;
+	if( !volumes[1]->isDecoded() || volumes[0]->isDecoded() )
+		return false;
+	const real32 *voxels = static_cast<const ScalarField &>(*fields[0]).getRawPointer();
+	for( int i=0;i<12*14*16;++i )
+		if( voxels[i] != float(i) )
+			return false;
+	return true;
+}
+
+// fills the components of attr with small values of its native type
+template<typename T>
+void fillAttribute( Attribute::Ptr attr, float scale )
+{
+	T *data = (T *)attr->getRawPointer();
+	for( int i=0, numComponents = int(attr->numElements())*attr->numComponents();i<numComponents;++i )
+		data[i] = T( float(i%100)*scale );
+}
+
+// attributes keep their storage through export and import (ascii and binary)
+bool testNativeStorage()
+{
+	const int numPoints = 1500;
+	struct Storage{ const char *name; Attribute::ComponentType type; };
+	Storage storages[] = { {"half", Attribute::HALF}, {"double", Attribute::DOUBLE}, {"int8", Attribute::INT8}, {"uint8", Attribute::UINT8}, {"int16", Attribute::INT16}, {"int64", Attribute::INT64} };
+
+	HouGeo::Ptr houGeo = HouGeo::create();
+	Attribute::Ptr P = Attribute::createV4f();
+	for( int i=0;i<numPoints;++i )
+		P->appendElement<math::V4f>( math::V4f( float(i), 0.0f, 0.0f, 1.0f ) );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "P", P ) );
+	for( auto &storage:storages )
+	{
+		Attribute::Ptr attr = std::make_shared<Attribute>( 2, storage.type );
+		attr->resize( numPoints );
+		switch( storage.type )
+		{
+		case Attribute::HALF:fillAttribute<real16>( attr, 0.5f );break;
+		case Attribute::DOUBLE:fillAttribute<real64>( attr, 0.1f );break;
+		case Attribute::INT8:fillAttribute<sbyte>( attr, -1.0f );break;
+		case Attribute::UINT8:fillAttribute<ubyte>( attr, 2.0f );break;
+		case Attribute::INT16:fillAttribute<sint16>( attr, -300.0f );break;
+		default:fillAttribute<sint64>( attr, 1e8f );break;
+		}
+		houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( storage.name, attr ) );
+	}
+
+	for( int binary=0;binary<2;++binary )
+	{
+		std::stringstream file;
+		if( !HouGeoIO::xport( &file, houGeo, binary != 0 ) )
+			return false;
+		HouGeo::Ptr result = HouGeoIO::import( &file );
+		if( !result )
+			return false;
+		for( auto &storage:storages )
+		{
+			HouGeo::HouAttribute::Ptr attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>( houGeo->getPointAttribute( storage.name ) );
+			HouGeo::HouAttribute::Ptr resultAttr = std::dynamic_pointer_cast<HouGeo::HouAttribute>( result->getPointAttribute( storage.name ) );
+			if( !resultAttr || (resultAttr->getStorage() != attr->getStorage()) || (resultAttr->getNumElements() != numPoints) )
+				return false;
+			if( memcmp( resultAttr->m_attr->data(), attr->m_attr->data(), size_t(numPoints*attr->m_attr->elementSize()) ) != 0 )
+				return false;
+		}
+	}
+	return true;
+}
+
+// point and primitive groups come back with the same bits (binary files keep the bitstream, ascii files give one flag per element)
+bool testGroups()
+{
+	// each volume adds a point
+	const int numPoints = 1001;
+	HouGeo::Ptr houGeo = HouGeo::create();
+	Attribute::Ptr P = Attribute::createV4f();
+	for( int i=0;i<numPoints-3;++i )
+		P->appendElement<math::V4f>( math::V4f( float(i), 0.0f, 0.0f, 1.0f ) );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "P", P ) );
+	for( int i=0;i<3;++i )
+		houGeo->addPrimitive( rampVolume( math::V3i( 4, 4, 4 ) ) );
+
+	BitSet::Ptr thirds = BitSet::create( numPoints );
+	for( int i=0;i<numPoints;i+=3 )
+		thirds->set( i );
+	BitSet::Ptr middle = BitSet::create( 3 );
+	middle->set( 1 );
+	houGeo->setPointGroup( "thirds", thirds );
+	houGeo->setPointGroup( "none", BitSet::create( numPoints ) );
+	houGeo->setPointGroup( "all", BitSet::create( numPoints, true ) );
+	houGeo->setPrimitiveGroup( "middle", middle );
+
+	for( int binary=0;binary<2;++binary )
+	{
+		std::stringstream file;
+		if( !HouGeoIO::xport( &file, houGeo, binary != 0 ) )
+			return false;
+		HouGeo::Ptr result = HouGeoIO::import( &file );
+		if( !result )
+			return false;
+		const char *pointGroups[] = { "thirds", "none", "all" };
+		for( auto name:pointGroups )
+		{
+			BitSet::Ptr group = houGeo->getPointGroup( name );
+			BitSet::Ptr resultGroup = result->getPointGroup( name );
+			if( !resultGroup || (resultGroup->size() != numPoints) || (resultGroup->count() != group->count()) )
+				return false;
+			for( int i=0;i<numPoints;++i )
+				if( resultGroup->test( i ) != group->test( i ) )
+					return false;
+		}
+		BitSet::Ptr resultMiddle = result->getPrimitiveGroup( "middle" );
+		if( !resultMiddle || (resultMiddle->size() != 3) || (resultMiddle->count() != 1) || !resultMiddle->test( 1 ) )
+			return false;
+	}
+	return true;
+}
+
+// views share the data of their source, const reads go through the view's stride and writes copy the data of the written attribute only
+bool testAttributeViews()
+{
+	Attribute::Ptr source = Attribute::createV4f();
+	for( int i=0;i<100;++i )
+		source->appendElement<math::V4f>( math::V4f( float(i), float(i*2), float(i*3), 1.0f ) );
+	Attribute::Ptr view = Attribute::createView( source, 3 );
+	if( !view->isShared() || view->isPacked() || (view->data() != source->data()) )
+		return false;
+	const Attribute &constView = *view;
+	for( int i=0;i<100;++i )
+	{
+		const math::V3f &p = constView.get<math::V3f>( i );
+		if( (p.x != float(i))||(p.y != float(i*2))||(p.z != float(i*3)) )
+			return false;
+	}
+	if( !view->isShared() )
+		return false;
+
+	view->get<math::V3f>( 10 ).x = -1.0f;
+	if( view->isShared() || source->isShared() || !view->isPacked() )
+		return false;
+	const Attribute &constSource = *source;
+	return (constView.get<math::V3f>( 10 ).x == -1.0f) && (constView.get<math::V3f>( 11 ).y == 22.0f) && (constSource.get<math::V4f>( 10 ).x == 10.0f);
+}
+
+// without seams the geometry positions alias the houdini P attribute, vertex attributes with seams split points which take their positions along
+bool testSplitPoints()
+{
+	if( !HouGeoIO::xport( "roundtrip_grid.bgeo", Geometry::createGrid( 6, 5 ) ) )
+		return false;
+	std::ifstream in( "roundtrip_grid.bgeo", std::ios_base::in | std::ios_base::binary );
+	HouGeo::Ptr houGeo = HouGeoIO::import( &in );
+	if( !houGeo )
+		return false;
+	HouGeo::HouAttribute::Ptr houP = std::dynamic_pointer_cast<HouGeo::HouAttribute>( houGeo->getPointAttribute( "P" ) );
+	Geometry::Ptr geo = HouGeoIO::importGeometry( houGeo );
+	if( !geo || !houP || (geo->getAttr( "P" )->numElements() != 30) )
+		return false;
+	if( !geo->getAttr( "P" )->isShared() || (geo->getAttr( "P" )->data() != houP->m_attr->data()) )
+		return false;
+
+	// unique value per vertex splits every point which is used by more than one vertex
+	std::vector<HouGeoAdapter::Primitive::Ptr> primitives;
+	houGeo->getPrimitives( primitives );
+	HouGeo::HouPoly::Ptr poly = std::dynamic_pointer_cast<HouGeo::HouPoly>( primitives[0] );
+	int numVertices = int(poly->m_vertices.size()); // point per vertex
+	Attribute::Ptr Cd = Attribute::createV3f();
+	for( int i=0;i<numVertices;++i )
+		Cd->appendElement<math::V3f>( math::V3f( float(i), 0.0f, 0.0f ) );
+	houGeo->setVertexAttribute( std::make_shared<HouGeo::HouAttribute>( "Cd", Cd ) );
+	geo = HouGeoIO::importGeometry( houGeo );
+	if( !geo || (geo->getAttr( "P" )->numElements() != numVertices) || (geo->getAttr( "Cd" )->numElements() != numVertices) )
+		return false;
+	const Attribute &P = *geo->getAttr( "P" );
+	const Attribute &resultCd = *geo->getAttr( "Cd" );
+	const Attribute &sourceP = *houP->m_attr;
+	for( int i=0;i<numVertices;++i )
+	{
+		int vertex = int(resultCd.get<math::V3f>( i ).x);
+		const math::V3f &p = P.get<math::V3f>( i );
+		const math::V4f &source = sourceP.get<math::V4f>( poly->m_vertices[vertex] );
+		if( (p.x != source.x)||(p.y != source.y)||(p.z != source.z) )
+			return false;
+	}
+	return true;
+}
+
+// polygons with mixed vertex counts are triangulated, concave polygons are covered without overlap
+bool testTriangulation()
+{
+	// concave L shape (starting at a vertex which cant be fanned from), quad and triangle in the xz plane (area 3 + 1 + 0.5)
+	float positions[][2] = { {2,1}, {1,1}, {1,2}, {0,2}, {0,0}, {2,0}, {3,0}, {4,0}, {4,1}, {3,1}, {5,0}, {6,0}, {5,1} };
+	int vertexCounts[] = { 6, 4, 3 };
+	HouGeo::Ptr houGeo = HouGeo::create();
+	Attribute::Ptr P = Attribute::createV4f();
+	for( auto &p:positions )
+		P->appendElement<math::V4f>( math::V4f( p[0], 0.0f, p[1], 1.0f ) );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "P", P ) );
+	HouGeo::HouPoly::Ptr poly = std::make_shared<HouGeo::HouPoly>();
+	poly->m_numPolys = 3;
+	poly->m_closed = true;
+	for( int i=0, vertex=0;i<3;vertex+=vertexCounts[i++] )
+	{
+		poly->m_perPolyVertexCount.push_back( vertexCounts[i] );
+		poly->m_perPolyVertexListOffset.push_back( vertex );
+	}
+	HouGeo::HouTopology::Ptr topology = std::make_shared<HouGeo::HouTopology>();
+	for( int i=0;i<13;++i )
+	{
+		topology->indexBuffer.push_back( i );
+		poly->m_vertices.push_back( i );
+	}
+	houGeo->setTopology( topology );
+	houGeo->addPrimitive( poly );
+
+	Geometry::Ptr geo = HouGeoIO::importGeometry( houGeo, true );
+	if( !geo || (geo->primitiveType() != Geometry::TRIANGLE) || (geo->m_indexBuffer.size() != (4+2+1)*3) )
+		return false;
+	const Attribute &resultP = *geo->getAttr( "P" );
+	float area = 0.0f, signedArea = 0.0f;
+	for( size_t i=0;i<geo->m_indexBuffer.size();i+=3 )
+	{
+		math::V3f p0 = resultP.get<math::V3f>( geo->m_indexBuffer[i] );
+		math::V3f p1 = resultP.get<math::V3f>( geo->m_indexBuffer[i+1] );
+		math::V3f p2 = resultP.get<math::V3f>( geo->m_indexBuffer[i+2] );
+		float y = math::cross( p1-p0, p2-p0 ).y*0.5f;
+		area += std::abs( y );
+		signedArea += y;
+	}
+	return (std::abs( area - 4.5f ) < 1.0e-5f) && (std::abs( std::abs( signedArea ) - 4.5f ) < 1.0e-5f);
+}
+
+// attribute blocks of the stream reader give the same data as a full import (pages span several blocks, constant pages are expanded)
+bool testStreamBlocks()
+{
+	const int numPoints = 2500;
+	HouGeo::Ptr houGeo = HouGeo::create();
+	Attribute::Ptr P = Attribute::createV4f();
+	Attribute::Ptr id = std::make_shared<Attribute>( 1, Attribute::INT );
+	Attribute::Ptr weight = std::make_shared<Attribute>( 2, Attribute::DOUBLE );
+	for( int i=0;i<numPoints;++i )
+	{
+		P->appendElement<math::V4f>( math::V4f( float(i), float(i%7), 0.0f, 1.0f ) );
+		id->appendElement<sint32>( i*3 );
+		weight->appendElement<real64>( 0.5, i < 1024 ? 0.25 : double(i) );
+	}
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "P", P ) );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "id", id ) );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "weight", weight ) );
+	HouGeoIO::ExportOptions options;
+	options.constantPages = true;
+	options.splitPacking = true;
+	if( !HouGeoIO::xport( "roundtrip_stream.bgeo", houGeo, false, options ) )
+		return false;
+
+	std::map<std::string, std::string> streamed;
+	std::map<std::string, sint64> nextElement;
+	bool inOrder = true;
+	bool read = HouGeoStream::read( "roundtrip_stream.bgeo", [&]( const HouGeoStream::Block &block )
+	{
+		int size = HouGeoAdapter::AttributeAdapter::storageSize( block.storage )*block.tupleSize;
+		inOrder &= (block.owner == HouGeoStream::OWNER_POINT) && (block.firstElement == nextElement[block.name]);
+		nextElement[block.name] = block.firstElement + block.numElements;
+		streamed[block.name].append( (const char *)block.data, size_t(block.numElements*size) );
+	});
+	if( !read || !inOrder )
+		return false;
+
+	std::ifstream in( "roundtrip_stream.bgeo", std::ios_base::in | std::ios_base::binary );
+	HouGeo::Ptr result = HouGeoIO::import( &in );
+	if( !result || (streamed.size() != 3) )
+		return false;
+	for( auto &it:streamed )
+	{
+		HouGeo::HouAttribute::Ptr attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>( result->getPointAttribute( it.first ) );
+		if( !attr || (it.second.size() != size_t(numPoints*attr->m_attr->elementSize())) )
+			return false;
+		if( memcmp( it.second.data(), attr->m_attr->data(), it.second.size() ) != 0 )
+			return false;
+	}
+	return true;
+}
+
+// probe reads the counts and the schema without decoding payloads, they agree with a full import
+bool testProbe()
+{
+	HouGeo::Ptr houGeo = HouGeo::create();
+	houGeo->addPrimitive( rampVolume( math::V3i( 10, 12, 14 ) ) );
+	houGeo->addPrimitive( rampVolume( math::V3i( 3, 4, 5 ) ) );
+	Attribute::Ptr id = std::make_shared<Attribute>( 1, Attribute::INT64 );
+	id->appendElement<sint64>( 1 );
+	id->appendElement<sint64>( 2 );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "id", id ) );
+	houGeo->setPointGroup( "first", BitSet::create( 2, true ) );
+	houGeo->setPrimitiveGroup( "big", BitSet::create( 2 ) );
+	if( !HouGeoIO::xport( "roundtrip_probe.bgeo", houGeo ) )
+		return false;
+
+	HouGeoIO::Metadata metadata = HouGeoIO::probe( "roundtrip_probe.bgeo" );
+	std::ifstream in( "roundtrip_probe.bgeo", std::ios_base::in | std::ios_base::binary );
+	HouGeo::Ptr result = HouGeoIO::import( &in );
+	if( !metadata.valid || !result )
+		return false;
+	if( (metadata.pointCount != result->pointcount())||(metadata.vertexCount != result->vertexcount())||(metadata.primitiveCount != result->primitivecount())||(metadata.primitiveCount != 2) )
+		return false;
+	if( (metadata.pointAttributes.size() != 2)||(metadata.pointGroups.size() != 1)||(metadata.pointGroups[0] != "first")||(metadata.primitiveGroups.size() != 1)||(metadata.primitiveGroups[0] != "big") )
+		return false;
+	for( auto &info:metadata.pointAttributes )
+	{
+		HouGeoAdapter::AttributeAdapter::Ptr attr = result->getPointAttribute( info.name );
+		if( !attr || (info.type != "numeric")||(HouGeoAdapter::AttributeAdapter::storage( info.storage ) != attr->getStorage())||(info.tupleSize != attr->getTupleSize()) )
+			return false;
+	}
+	if( (metadata.primitiveTypes.size() != 1)||(metadata.primitiveTypes.begin()->second != 2)||(metadata.volumeResolutions.size() != 2) )
+		return false;
+	const math::V3i &res = metadata.volumeResolutions[1];
+	return (res.x == 3)&&(res.y == 4)&&(res.z == 5);
+}
+
+// attributes loaded through the index equal the full import, the sidecar index is reused until the file changes
+// (a rewrite of the same size with the old modification time is caught by the content hash)
+bool testIndex()
+{
+	HouGeo::Ptr houGeo = HouGeo::create();
+	Attribute::Ptr P = Attribute::createV4f();
+	for( int i=0;i<3000;++i )
+		P->appendElement<math::V4f>( math::V4f( float(i), 1.0f, 2.0f, 1.0f ) );
+	houGeo->setPointAttribute( std::make_shared<HouGeo::HouAttribute>( "P", P ) );
+	std::remove( HouGeoIndex::sidecarPath( "roundtrip_index.bgeo" ).c_str() );
+	if( !HouGeoIO::xport( "roundtrip_index.bgeo", houGeo ) )
+		return false;
+
+	HouGeoIndex::Ptr index = HouGeoIndex::load( "roundtrip_index.bgeo" );
+	HouGeoIndex::Ptr sidecar = HouGeoIndex::read( HouGeoIndex::sidecarPath( "roundtrip_index.bgeo" ) );
+	if( !index || !sidecar || (sidecar->entries.size() != index->entries.size()) || (sidecar->fileTime != index->fileTime) || (sidecar->fileHash != index->fileHash) )
+		return false;
+	std::ifstream in( "roundtrip_index.bgeo", std::ios_base::in | std::ios_base::binary );
+	HouGeo::HouAttribute::Ptr indexedP = sidecar->loadAttribute( &in, HouGeoIndex::ENTRY_POINT_ATTRIBUTE, "P" );
+	in.close();
+	if( !indexedP || (indexedP->getNumElements() != 3000) || (static_cast<const Attribute &>(*indexedP->m_attr).get<math::V4f>( 2999 ).x != 2999.0f) )
+		return false;
+
+	// same size, different content (within the last block), old modification time
+	struct stat before;
+	stat( "roundtrip_index.bgeo", &before );
+	P->set<math::V4f>( 2999, math::V4f( -1.0f, 1.0f, 2.0f, 1.0f ) );
+	if( !HouGeoIO::xport( "roundtrip_index.bgeo", houGeo ) )
+		return false;
+	struct timespec times[2] = { before.st_atim, before.st_mtim };
+	utimensat( AT_FDCWD, "roundtrip_index.bgeo", times, 0 );
+	index = HouGeoIndex::load( "roundtrip_index.bgeo" );
+	if( index->fileHash == sidecar->fileHash )
+		return false;
+	in.open( "roundtrip_index.bgeo", std::ios_base::in | std::ios_base::binary );
+	indexedP = index->loadAttribute( &in, HouGeoIndex::ENTRY_POINT_ATTRIBUTE, "P" );
+	return indexedP && (static_cast<const Attribute &>(*indexedP->m_attr).get<math::V4f>( 2999 ).x == -1.0f);
+}
+
+// frames are read in order, a frame which is missing is not cached and loads once the file exists
+bool testSequence()
+{
+	for( int frame=1;frame<=4;++frame )
+		std::remove( HouGeoSequence::framePath( "roundtrip_sequence.$F4.bgeo", frame ).c_str() );
+	for( int frame=1;frame<=4;++frame )
+		if( (frame != 3) && !HouGeoIO::xport( HouGeoSequence::framePath( "roundtrip_sequence.$F4.bgeo", frame ), rampVolume( math::V3i( frame, 2, 2 ) ) ) )
+			return false;
+
+	HouGeoSequence::Ptr sequence = HouGeoSequence::create( "roundtrip_sequence.$F4.bgeo", 1, 4, HouGeoSequence::CONTENT_VOLUME, 2 );
+	for( int frame=1;frame<=4;++frame )
+	{
+		ScalarField::Ptr volume = sequence->getVolume( frame );
+		if( (frame == 3) != !volume )
+			return false;
+		if( volume && (volume->getResolution().x != frame) )
+			return false;
+	}
+	if( sequence->getVolume( 0 ) || sequence->getVolume( 5 ) || (HouGeoSequence::framePath( "a.$F4.bgeo", 12 ) != "a.0012.bgeo") )
+		return false;
+
+	if( !HouGeoIO::xport( HouGeoSequence::framePath( "roundtrip_sequence.$F4.bgeo", 3 ), rampVolume( math::V3i( 3, 2, 2 ) ) ) )
+		return false;
+	ScalarField::Ptr volume = sequence->getVolume( 3 );
+	return volume && (volume->getResolution().x == 3) && (sequence->getStats().numFrames == 4);
+}
+
+// frames share unchanged entries with the reference frame (topology, polygons and groups by pointer, attributes copy on write)
+// and decode the changed ones, the result equals a plain import
+bool testSequenceFrames()
+{
+	if( !HouGeoIO::xport( "roundtrip_frame.bgeo", Geometry::createGrid( 6, 5 ) ) )
+		return false;
+	std::ifstream in( "roundtrip_frame.bgeo", std::ios_base::in | std::ios_base::binary );
+	HouGeo::Ptr houGeo = HouGeoIO::import( &in );
+	in.close();
+	if( !houGeo )
+		return false;
+	BitSet::Ptr group = BitSet::create( 30 );
+	group->set( 7 );
+	houGeo->setPointGroup( "seven", group );
+	Attribute::Ptr P = std::dynamic_pointer_cast<HouGeo::HouAttribute>( houGeo->getPointAttribute( "P" ) )->m_attr;
+	std::vector<HouGeoIO::SequenceFrame::Ptr> frames;
+	for( int i=0;i<3;++i )
+	{
+		// the last frame has the same P as the second
+		if( i == 1 )
+			P->get<math::V4f>( 3 ).y = 1.0f;
+		std::ostringstream path;
+		path << "roundtrip_frame" << i << ".bgeo";
+		if( !HouGeoIO::xport( path.str(), houGeo ) )
+			return false;
+		frames.push_back( HouGeoIO::importFrame( path.str(), frames.empty() ? HouGeoIO::SequenceFrame::Ptr() : frames.back() ) );
+		if( !frames.back()->houGeo )
+			return false;
+
+		// same content as a plain import
+		std::ifstream file( path.str().c_str(), std::ios_base::in | std::ios_base::binary );
+		HouGeo::Ptr plain = HouGeoIO::import( &file );
+		const char *names[] = { "P", "UV" };
+		for( auto name:names )
+		{
+			HouGeo::HouAttribute::Ptr attr = std::dynamic_pointer_cast<HouGeo::HouAttribute>( frames.back()->houGeo->getPointAttribute( name ) );
+			HouGeo::HouAttribute::Ptr plainAttr = std::dynamic_pointer_cast<HouGeo::HouAttribute>( plain->getPointAttribute( name ) );
+			if( !attr || (attr->getNumElements() != 30) || memcmp( attr->m_attr->data(), plainAttr->m_attr->data(), size_t(30*plainAttr->m_attr->elementSize()) ) )
+				return false;
+		}
+		if( !frames.back()->houGeo->getPointGroup( "seven" ) || (frames.back()->houGeo->getPointGroup( "seven" )->count() != 1) )
+			return false;
+	}
+
+	// first frame decodes everything, the second P only, the third nothing
+	if( (frames[0]->numShared != 0)||(frames[1]->numDecoded != 1)||(frames[2]->numDecoded != 0) )
+		return false;
+	HouGeo::Ptr first = frames[0]->houGeo, second = frames[1]->houGeo;
+	std::vector<HouGeoAdapter::Primitive::Ptr> firstPrimitives, secondPrimitives;
+	first->getPrimitives( firstPrimitives );
+	second->getPrimitives( secondPrimitives );
+	HouGeo::HouAttribute::Ptr firstUV = std::dynamic_pointer_cast<HouGeo::HouAttribute>( first->getPointAttribute( "UV" ) );
+	HouGeo::HouAttribute::Ptr secondUV = std::dynamic_pointer_cast<HouGeo::HouAttribute>( second->getPointAttribute( "UV" ) );
+	if( (first->getTopology() != second->getTopology()) || (firstPrimitives[0] != secondPrimitives[0]) ||
+		(first->getPointGroup( "seven" ) != second->getPointGroup( "seven" )) || (firstUV->m_attr->data() != secondUV->m_attr->data()) )
+		return false;
+
+	// entries which changed their size are decoded without being hashed
+	if( !HouGeoIO::xport( "roundtrip_frame3.bgeo", Geometry::createGrid( 7, 5 ) ) )
+		return false;
+	HouGeoIO::SequenceFrame::Ptr resized = HouGeoIO::importFrame( "roundtrip_frame3.bgeo", frames.back() );
+	return resized->houGeo && (resized->houGeo->pointcount() == 35) && (resized->numShared == 0) && !resized->signatures.count( "topology" ) && !resized->signatures.count( "pointattribute:P" );
+}
+
+// every file of a batch is delivered once with the geometry of a single import (or an error), an exception thrown by the
+// callback stops the batch and reaches the caller
+bool testBatch()
+{
+	std::vector<std::string> paths;
+	for( int i=0;i<6;++i )
+	{
+		std::ostringstream path;
+		path << "roundtrip_batch" << i << ".bgeo";
+		if( !HouGeoIO::xport( path.str(), Geometry::createGrid( 4+i, 3+2*i ) ) )
+			return false;
+		paths.push_back( path.str() );
+	}
+	paths.push_back( "roundtrip_batch_missing.bgeo" );
+
+	// a budget of one byte admits one file at a time
+	sint64 budgets[] = { sint64(1) << 30, 1 };
+	for( auto budget:budgets )
+	{
+		std::vector<int> delivered( paths.size(), 0 );
+		bool valid = true;
+		HouGeoBatch::importGeometry( paths, [&]( const HouGeoBatch::Result &result )
+		{
+			++delivered[result.index];
+			if( result.index == 6 )
+			{
+				valid &= !result.geometry && !result.error.empty();
+				return;
+			}
+			Geometry::Ptr single = HouGeoIO::importGeometry( result.path );
+			valid &= result.geometry && (result.path == paths[result.index]) && (result.geometry->getAttr( "P" )->numElements() == single->getAttr( "P" )->numElements()) && (result.geometry->m_indexBuffer == single->m_indexBuffer);
+		}, budget, 3 );
+		if( !valid || (std::count( delivered.begin(), delivered.end(), 1 ) != int(paths.size())) )
+			return false;
+	}
+
+	int numCalls = 0;
+	try
+	{
+		HouGeoBatch::importGeometry( paths, [&]( const HouGeoBatch::Result & )
+		{
+			if( ++numCalls == 2 )
+				throw std::runtime_error( "stop" );
+		}, 1, 2 );
+	}catch( std::runtime_error &e )
+	{
+		return (std::string( e.what() ) == "stop") && (numCalls == 2);
+	}
+	return false;
+}
+
+// writes the same data through mapped and buffered FileSinks, mapping fails if the file can't be resized to the preallocated size
+bool testFileSink()
+{
+	std::string content[3];
+	for( int mode=0;mode<3;++mode )
+	{
+		std::string path = "roundtrip_sink" + std::to_string( mode ) + ".bgeo";
+		{
+			json::FileSink sink( path, 64, mode != 0, mode == 2 ? sint64(1) << 62 : 0 );
+			json::BinaryWriter writer( &sink );
+			writer.jsonBeginArray();
+			for( int i=0;i<1000;++i )
+			{
+				writer.jsonString( "value" );
+				writer.jsonInt( i );
+			}
+			writer.jsonEndArray();
+			if( !sink.flush() || !sink.close() )
+				return false;
+		}
+		content[mode] = fileContent( path );
+	}
+	return !content[0].empty() && (content[0] == content[1]) && (content[0] == content[2]);
+}
+
+// half of the volume is zero (constant tiles), the other half is a ramp which is written as fpreal16
+bool testVolumeTiles()
+{
+	ScalarField::Ptr field = std::make_shared<ScalarField>();
+	field->resize( math::V3i( 40, 35, 20 ) );
+	math::V3i res = field->getResolution();
+	real32 *voxels = field->getRawPointer();
+	for( int k=0;k<res.z;++k )
+		for( int j=0;j<res.y;++j )
+			for( int i=0;i<res.x;++i )
+				voxels[(k*res.y + j)*res.x + i] = i < 16 ? 0.0f : float(i + j + k)*0.25f;
+
+	HouGeoIO::ExportOptions options;
+	options.constantTiles = true;
+	options.halfPrecisionTiles = true;
+	if( !HouGeoIO::xport( "roundtrip_volume.bgeo", field, options ) )
+		return false;
+	std::string log = fileLog( "roundtrip_volume.bgeo" );
+	if( (log.find( "constant" ) == std::string::npos)||(log.find( "fpreal16" ) == std::string::npos) )
+		return false;
+
+	ScalarField::Ptr result = HouGeoIO::importVolume( "roundtrip_volume.bgeo" );
+	if( !result )
+		return false;
+	math::V3i resultRes = result->getResolution();
+	if( (resultRes.x != res.x)||(resultRes.y != res.y)||(resultRes.z != res.z) )
+		return false;
+	const real32 *resultVoxels = static_cast<const ScalarField &>(*result).getRawPointer();
+	for( sint64 i=0, numVoxels = sint64(res.x)*res.y*res.z;i<numVoxels;++i )
+		// ramp values stay below 32 where fpreal16 has at least 1/64 precision
+		if( std::abs( resultVoxels[i] - voxels[i] ) > 1.0f/64.0f )
+			return false;
+	return true;
+}
+
+// point attribute with constant w (collapses with split packing) and pages which are entirely constant
+bool testConstantPages()
+{
+	const int numPoints = 3000;
+	Geometry::Ptr geo = std::make_shared<Geometry>( Geometry::POINT );
+	Attribute::Ptr P = Attribute::createV3f( numPoints );
+	Attribute::Ptr Cd = Attribute::createV4f( numPoints );
+	for( int i=0;i<numPoints;++i )
+	{
+		P->set<math::V3f>( i, math::V3f( float(i), float(i%7), 1.0f ) );
+		Cd->set<math::V4f>( i, i < 2048 ? math::V4f( 0.5f, 0.25f, 0.125f, 1.0f ) : math::V4f( float(i), 0.0f, 0.0f, 1.0f ) );
+	}
+	geo->setAttr( "P", P );
+	geo->setAttr( "Cd", Cd );
+
+	HouGeoIO::ExportOptions options;
+	options.constantPages = true;
+	options.splitPacking = true;
+	if( !HouGeoIO::xport( "roundtrip_pages.bgeo", geo, options ) )
+		return false;
+	if( fileLog( "roundtrip_pages.bgeo" ).find( "constantpageflags" ) == std::string::npos )
+		return false;
+
+	Geometry::Ptr result = HouGeoIO::importGeometry( "roundtrip_pages.bgeo" );
+	Attribute::Ptr resultP = result ? result->getAttr( "P" ) : Attribute::Ptr();
+	Attribute::Ptr resultCd = result ? result->getAttr( "Cd" ) : Attribute::Ptr();
+	if( !resultP || !resultCd || (resultP->numElements() != numPoints) || (resultCd->numElements() != numPoints) )
+		return false;
+	// const access reads through the views without detaching them
+	const Attribute &sourceP = *P, &sourceCd = *Cd, &loadedP = *resultP, &loadedCd = *resultCd;
+	for( int i=0;i<numPoints;++i )
+	{
+		const math::V3f &p = loadedP.get<math::V3f>( i );
+		const math::V4f &c = loadedCd.get<math::V4f>( i );
+		const math::V3f &p0 = sourceP.get<math::V3f>( i );
+		const math::V4f &c0 = sourceCd.get<math::V4f>( i );
+		if( (p.x != p0.x)||(p.y != p0.y)||(p.z != p0.z) )
+			return false;
+		if( (c.x != c0.x)||(c.y != c0.y)||(c.z != c0.z)||(c.w != c0.w) )
+			return false;
+	}
+	return true;
+}
+
+// string attribute with repeated values goes through the string table
+bool testStringTable()
+{
+	const int numPoints = 2500;
+	const char *names[] = { "left", "right", "", "left_arm" };
+	HouGeo::Ptr houGeo = HouGeo::create();
+	HouGeo::HouAttribute::Ptr P = std::make_shared<HouGeo::HouAttribute>( "P", Attribute::createV4f() );
+	HouGeo::HouAttribute::Ptr name = std::make_shared<HouGeo::HouAttribute>();
+	name->m_name = "name";
+	for( int i=0;i<numPoints;++i )
+	{
+		P->m_attr->appendElement<math::V4f>( math::V4f( float(i), 0.0f, 0.0f, 1.0f ) );
+		name->addString( names[(i/3)%4] );
+	}
+	P->numElements = numPoints;
+	houGeo->setPointAttribute( P );
+	houGeo->setPointAttribute( name );
+
+	for( int binary=0;binary<2;++binary )
+	{
+		std::stringstream file;
+		if( !HouGeoIO::xport( &file, houGeo, binary != 0 ) )
+			return false;
+		HouGeo::Ptr result = HouGeoIO::import( &file );
+		HouGeoAdapter::AttributeAdapter::Ptr resultName = result ? result->getPointAttribute( "name" ) : HouGeoAdapter::AttributeAdapter::Ptr();
+		if( !resultName || (resultName->getNumElements() != numPoints) )
+			return false;
+		const std::vector<std::string> *strings = resultName->getStrings();
+		if( !strings || (strings->size() != 4) )
+			return false;
+		for( int i=0;i<numPoints;++i )
+			if( resultName->getString( i ) != names[(i/3)%4] )
+				return false;
+	}
+	return true;
+}
+
+// geometry which is modified right after it has been queued is written as it was when it was queued
+bool testExportQueue()
+{
+	const int numPoints = 5000;
+	Geometry::Ptr geo = std::make_shared<Geometry>( Geometry::POINT );
+	Attribute::Ptr P = Attribute::createV3f( numPoints );
+	geo->setAttr( "P", P );
+
+	HouGeoExportQueue queue;
+	for( int frame=0;frame<3;++frame )
+	{
+		math::V3f *p = (math::V3f *)P->getRawPointer();
+		for( int i=0;i<numPoints;++i )
+			p[i] = math::V3f( float(i), float(frame), 0.0f );
+		std::string suffix = std::to_string( frame ) + ".bgeo";
+		if( !HouGeoIO::xport( "roundtrip_queue_reference" + suffix, geo ) )
+			return false;
+		queue.xport( "roundtrip_queue" + suffix, geo );
+	}
+	queue.wait();
+
+	for( int frame=0;frame<3;++frame )
+	{
+		std::string suffix = std::to_string( frame ) + ".bgeo";
+		std::string reference = fileContent( "roundtrip_queue_reference" + suffix );
+		if( reference.empty() || (fileContent( "roundtrip_queue" + suffix ) != reference) )
+			return false;
+	}
+	return true;
+}
+
+// closed polygons with sequential vertices are written as Polygon_run and come back with the same topology as polygon runs
+bool testPolygonRun()
+{
+	Geometry::Ptr geo = Geometry::createGrid( 12, 9 );
+
+	HouGeoIO::ExportOptions options;
+	if( options.polygonRuns || !HouGeoIO::xport( "roundtrip_polyrun.bgeo", geo, options ) )
+		return false;
+	Geometry::Ptr reference = HouGeoIO::importGeometry( "roundtrip_polyrun.bgeo" );
+	if( !reference || (fileLog( "roundtrip_polyrun.bgeo" ).find( "Polygon_run" ) != std::string::npos) )
+		return false;
+
+	options.polygonRuns = true;
+	if( !HouGeoIO::xport( "roundtrip_polygonrun.bgeo", geo, options ) )
+		return false;
+	if( fileLog( "roundtrip_polygonrun.bgeo" ).find( "Polygon_run" ) == std::string::npos )
+		return false;
+
+	Geometry::Ptr result = HouGeoIO::importGeometry( "roundtrip_polygonrun.bgeo" );
+	if( !result || (result->m_indexBuffer != reference->m_indexBuffer) )
+		return false;
+
+	// polygons of a loaded file keep their vertex numbering and are written as run again
+	std::ifstream in( "roundtrip_polygonrun.bgeo", std::ios_base::in | std::ios_base::binary );
+	HouGeo::Ptr houGeo = HouGeoIO::import( &in );
+	if( !houGeo || !HouGeoIO::xport( "roundtrip_polygonrun2.bgeo", houGeo, false, options ) )
+		return false;
+	if( fileLog( "roundtrip_polygonrun2.bgeo" ).find( "Polygon_run" ) == std::string::npos )
+		return false;
+	result = HouGeoIO::importGeometry( "roundtrip_polygonrun2.bgeo" );
+	return result && (result->m_indexBuffer == reference->m_indexBuffer);
+}
+
+
+
+int main(void)
+{
+	int numFailed = 0;
+	numFailed += !check( "shared voxels", testSharedVoxels() );
+	numFailed += !check( "region import", testRegionImport() );
+	numFailed += !check( "lazy decode", testLazyDecode() );
+	numFailed += !check( "native storage", testNativeStorage() );
+	numFailed += !check( "groups", testGroups() );
+	numFailed += !check( "attribute views", testAttributeViews() );
+	numFailed += !check( "split points", testSplitPoints() );
+	numFailed += !check( "triangulation", testTriangulation() );
+	numFailed += !check( "stream blocks", testStreamBlocks() );
+	numFailed += !check( "probe", testProbe() );
+	numFailed += !check( "index", testIndex() );
+	numFailed += !check( "sequence", testSequence() );
+	numFailed += !check( "sequence frames", testSequenceFrames() );
+	numFailed += !check( "batch", testBatch() );
+	numFailed += !check( "file sink", testFileSink() );
+	numFailed += !check( "volume tiles", testVolumeTiles() );
+	numFailed += !check( "constant pages", testConstantPages() );
+	numFailed += !check( "string table", testStringTable() );
+	numFailed += !check( "export queue", testExportQueue() );
+	numFailed += !check( "polygon run", testPolygonRun() );
+	return numFailed == 0 ? 0 : 1;
+}